@@ -0,0 +1,728 @@
+#ifndef ART_HPP
+#define ART_HPP
+
+#include <iostream>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Árvore radix adaptativa (Leis et al.): cada nível consome um byte da chave
+// e os nós internos crescem/encolhem entre 4, 16, 48 e 256 filhos. Trechos
+// sem ramificação são comprimidos no prefixo do nó (até MAX_PREFIX bytes
+// guardados; o restante é recuperado pela menor folha da subárvore).
+// Uma chave que termina exatamente num nó interno fica em `terminal`.
+template <typename Key, typename Value>
+class ART {
+    static_assert(std::is_same<Key, std::string>::value,
+                  "ART indexa apenas chaves std::string");
+public:
+    ART();
+    ~ART();
+    void insert(const Key& k);
+    // Valor de k, inserindo-o com value se ausente, numa só descida
+    Value insert_or_get(const Key& k, const Value& value);
+    void update(const Key& key, const Value& new_value);
+    Value get(const Key& key) const;
+    void remove(const Key& k);
+    bool contains(const Key& k) const;
+    void forEach(std::function<void(const Key&, const Value&)> func) const;
+    void prefix_scan(const Key& prefix, std::function<void(const Key&, const Value&)> func) const;
+    int size() const;
+    void clear();
+    void print(std::ostream& out = std::cout) const;
+    size_t get_comparisons() const;
+
+private:
+    static constexpr uint32_t MAX_PREFIX = 8;
+    enum NodeType : uint8_t { NODE4, NODE16, NODE48, NODE256 };
+
+    struct Leaf {
+        Key key;
+        Value value;
+    };
+
+    struct Inner {
+        NodeType type;
+        uint16_t num_children;
+        uint32_t prefix_len;
+        unsigned char prefix[MAX_PREFIX];
+        Leaf* terminal;  // chave que termina neste nó
+    };
+
+    struct Node4 : Inner {
+        unsigned char keys[4];
+        void* children[4];
+    };
+
+    struct Node16 : Inner {
+        unsigned char keys[16];
+        void* children[16];
+    };
+
+    struct Node48 : Inner {
+        unsigned char index[256];  // 0 = vazio, senão posição + 1
+        void* children[48];
+    };
+
+    struct Node256 : Inner {
+        void* children[256];
+    };
+
+    // Os filhos são ponteiros marcados: bit 0 ligado indica folha
+    static bool is_leaf(const void* p) { return reinterpret_cast<uintptr_t>(p) & 1; }
+    static Leaf* as_leaf(const void* p) {
+        return reinterpret_cast<Leaf*>(reinterpret_cast<uintptr_t>(p) & ~uintptr_t(1));
+    }
+    static void* tag(Leaf* l) { return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(l) | 1); }
+
+    void* m_root;
+    int m_size;
+    mutable size_t key_comparisons;
+
+    Leaf* new_leaf(const Key& k);
+    Leaf* find_leaf(const Key& k) const;
+    Leaf* insert_rec(void*& ref, const Key& k, size_t depth);
+    bool remove_rec(void*& ref, const Key& k, size_t depth);
+
+    void** find_child(Inner* n, unsigned char c) const;
+    void add_child(void*& ref, Inner* n, unsigned char c, void* child);
+    void remove_child(void*& ref, Inner* n, unsigned char c, void** slot);
+    void collapse(void*& ref, Inner* n);
+
+    uint32_t check_prefix(const Inner* n, const Key& k, size_t depth) const;
+    uint32_t prefix_mismatch(const Inner* n, const Key& k, size_t depth) const;
+    Leaf* minimum(const void* p) const;
+    static void copy_header(Inner* dst, const Inner* src);
+
+    void visit(const void* p, const std::function<void(const Key&, const Value&)>& func) const;
+    void destroy(void* p);
+};
+
+template <typename Key, typename Value>
+ART<Key, Value>::ART() {
+    m_root = nullptr;
+    m_size = 0;
+    key_comparisons = 0;
+}
+
+template <typename Key, typename Value>
+ART<Key, Value>::~ART() {
+    clear();
+}
+
+template <typename Key, typename Value>
+void ART<Key, Value>::insert(const Key& k) {
+    int before = m_size;
+    Leaf* l = insert_rec(m_root, k, 0);
+    if (m_size == before) l->value++;
+}
+
+template <typename Key, typename Value>
+Value ART<Key, Value>::insert_or_get(const Key& k, const Value& value) {
+    int before = m_size;
+    Leaf* l = insert_rec(m_root, k, 0);
+    if (m_size != before) l->value = value;
+    return l->value;
+}
+
+template <typename Key, typename Value>
+void ART<Key, Value>::update(const Key& key, const Value& new_value) {
+    Leaf* l = find_leaf(key);
+    if (l == nullptr) throw std::runtime_error("Chave não encontrada para atualização");
+    l->value = new_value;
+}
+
+template <typename Key, typename Value>
+Value ART<Key, Value>::get(const Key& key) const {
+    Leaf* l = find_leaf(key);
+    if (l == nullptr) throw std::runtime_error("Chave não encontrada");
+    return l->value;
+}
+
+template <typename Key, typename Value>
+void ART<Key, Value>::remove(const Key& k) {
+    if (remove_rec(m_root, k, 0)) m_size--;
+}
+
+template <typename Key, typename Value>
+bool ART<Key, Value>::contains(const Key& k) const {
+    return find_leaf(k) != nullptr;
+}
+
+template <typename Key, typename Value>
+void ART<Key, Value>::forEach(std::function<void(const Key&, const Value&)> func) const {
+    visit(m_root, func);
+}
+
+template <typename Key, typename Value>
+void ART<Key, Value>::prefix_scan(const Key& prefix, std::function<void(const Key&, const Value&)> func) const {
+    const void* p = m_root;
+    size_t depth = 0;
+    while (p != nullptr) {
+        if (is_leaf(p)) {
+            const Leaf* l = as_leaf(p);
+            key_comparisons++;
+            if (l->key.compare(0, prefix.size(), prefix) == 0) func(l->key, l->value);
+            return;
+        }
+        Inner* n = static_cast<Inner*>(const_cast<void*>(p));
+        if (depth == prefix.size()) break;
+        if (n->prefix_len) {
+            uint32_t mm = prefix_mismatch(n, prefix, depth);
+            // O prefixo buscado acabou dentro do prefixo comprimido: a subárvore inteira casa
+            if (depth + mm == prefix.size()) break;
+            if (mm < n->prefix_len) return;
+            depth += n->prefix_len;
+            if (depth == prefix.size()) break;
+        }
+        void** child = find_child(n, static_cast<unsigned char>(prefix[depth]));
+        if (child == nullptr) return;
+        p = *child;
+        depth++;
+    }
+    visit(p, func);
+}
+
+template <typename Key, typename Value>
+int ART<Key, Value>::size() const {
+    return m_size;
+}
+
+template <typename Key, typename Value>
+void ART<Key, Value>::clear() {
+    destroy(m_root);
+    m_root = nullptr;
+    m_size = 0;
+}
+
+template <typename Key, typename Value>
+void ART<Key, Value>::print(std::ostream& out) const {
+    forEach([&](const Key& k, const Value& v) {
+        out << k << " : " << v << '\n';
+    });
+}
+
+template <typename Key, typename Value>
+size_t ART<Key, Value>::get_comparisons() const {
+    return key_comparisons;
+}
+
+template <typename Key, typename Value>
+typename ART<Key, Value>::Leaf* ART<Key, Value>::new_leaf(const Key& k) {
+    m_size++;
+    return new Leaf{k, 1};
+}
+
+template <typename Key, typename Value>
+typename ART<Key, Value>::Leaf* ART<Key, Value>::find_leaf(const Key& k) const {
+    const void* p = m_root;
+    size_t depth = 0;
+    while (p != nullptr) {
+        if (is_leaf(p)) {
+            Leaf* l = as_leaf(p);
+            key_comparisons++;
+            return l->key == k ? l : nullptr;
+        }
+        Inner* n = static_cast<Inner*>(const_cast<void*>(p));
+        if (n->prefix_len) {
+            // Busca otimista: só os bytes guardados são conferidos, a folha valida o resto
+            if (check_prefix(n, k, depth) != std::min(n->prefix_len, MAX_PREFIX)) return nullptr;
+            depth += n->prefix_len;
+        }
+        if (depth > k.size()) return nullptr;
+        if (depth == k.size()) {
+            if (n->terminal == nullptr) return nullptr;
+            key_comparisons++;
+            return n->terminal->key == k ? n->terminal : nullptr;
+        }
+        void** child = find_child(n, static_cast<unsigned char>(k[depth]));
+        if (child == nullptr) return nullptr;
+        p = *child;
+        depth++;
+    }
+    return nullptr;
+}
+
+// Folha de k, criada com valor 1 se ela ainda não existia
+template <typename Key, typename Value>
+typename ART<Key, Value>::Leaf* ART<Key, Value>::insert_rec(void*& ref, const Key& k, size_t depth) {
+    if (ref == nullptr) {
+        Leaf* nl = new_leaf(k);
+        ref = tag(nl);
+        return nl;
+    }
+
+    if (is_leaf(ref)) {
+        Leaf* l = as_leaf(ref);
+        key_comparisons++;
+        if (l->key == k) return l;
+        // Divide a folha: o novo nó guarda o trecho comum das duas chaves
+        size_t limit = std::min(l->key.size(), k.size()) - depth;
+        size_t lcp = 0;
+        while (lcp < limit && l->key[depth + lcp] == k[depth + lcp]) lcp++;
+
+        Node4* nn = new Node4();
+        nn->type = NODE4;
+        nn->prefix_len = static_cast<uint32_t>(lcp);
+        std::memcpy(nn->prefix, k.data() + depth, std::min<size_t>(lcp, MAX_PREFIX));
+        void* nref = nn;
+
+        size_t d = depth + lcp;
+        Leaf* nl = new_leaf(k);
+        if (l->key.size() == d) nn->terminal = l;
+        else add_child(nref, nn, static_cast<unsigned char>(l->key[d]), ref);
+        if (k.size() == d) nn->terminal = nl;
+        else add_child(nref, nn, static_cast<unsigned char>(k[d]), tag(nl));
+        ref = nref;
+        return nl;
+    }
+
+    Inner* n = static_cast<Inner*>(ref);
+    if (n->prefix_len) {
+        uint32_t mm = prefix_mismatch(n, k, depth);
+        if (mm < n->prefix_len) {
+            // A chave diverge dentro do prefixo comprimido: quebra o prefixo em mm
+            Node4* nn = new Node4();
+            nn->type = NODE4;
+            nn->prefix_len = mm;
+            std::memcpy(nn->prefix, n->prefix, std::min(mm, MAX_PREFIX));
+            void* nref = nn;
+
+            unsigned char edge;
+            if (n->prefix_len <= MAX_PREFIX) {
+                edge = n->prefix[mm];
+                n->prefix_len -= mm + 1;
+                std::memmove(n->prefix, n->prefix + mm + 1, std::min(n->prefix_len, MAX_PREFIX));
+            } else {
+                const Leaf* min = minimum(n);
+                edge = static_cast<unsigned char>(min->key[depth + mm]);
+                n->prefix_len -= mm + 1;
+                std::memcpy(n->prefix, min->key.data() + depth + mm + 1, std::min(n->prefix_len, MAX_PREFIX));
+            }
+            add_child(nref, nn, edge, n);
+
+            size_t d = depth + mm;
+            Leaf* nl = new_leaf(k);
+            if (k.size() == d) nn->terminal = nl;
+            else add_child(nref, nn, static_cast<unsigned char>(k[d]), tag(nl));
+            ref = nref;
+            return nl;
+        }
+        depth += n->prefix_len;
+    }
+
+    if (depth == k.size()) {
+        if (n->terminal == nullptr) n->terminal = new_leaf(k);
+        return n->terminal;
+    }
+
+    void** child = find_child(n, static_cast<unsigned char>(k[depth]));
+    if (child != nullptr) return insert_rec(*child, k, depth + 1);
+    Leaf* nl = new_leaf(k);
+    add_child(ref, n, static_cast<unsigned char>(k[depth]), tag(nl));
+    return nl;
+}
+
+template <typename Key, typename Value>
+bool ART<Key, Value>::remove_rec(void*& ref, const Key& k, size_t depth) {
+    if (ref == nullptr) return false;
+
+    if (is_leaf(ref)) {
+        Leaf* l = as_leaf(ref);
+        key_comparisons++;
+        if (l->key != k) return false;
+        delete l;
+        ref = nullptr;
+        return true;
+    }
+
+    Inner* n = static_cast<Inner*>(ref);
+    if (n->prefix_len) {
+        if (check_prefix(n, k, depth) != std::min(n->prefix_len, MAX_PREFIX)) return false;
+        depth += n->prefix_len;
+    }
+    if (depth > k.size()) return false;
+
+    if (depth == k.size()) {
+        if (n->terminal == nullptr) return false;
+        key_comparisons++;
+        if (n->terminal->key != k) return false;
+        delete n->terminal;
+        n->terminal = nullptr;
+        collapse(ref, n);
+        return true;
+    }
+
+    unsigned char c = static_cast<unsigned char>(k[depth]);
+    void** child = find_child(n, c);
+    if (child == nullptr) return false;
+    if (is_leaf(*child)) {
+        Leaf* l = as_leaf(*child);
+        key_comparisons++;
+        if (l->key != k) return false;
+        delete l;
+        remove_child(ref, n, c, child);
+        return true;
+    }
+    return remove_rec(*child, k, depth + 1);
+}
+
+template <typename Key, typename Value>
+void** ART<Key, Value>::find_child(Inner* n, unsigned char c) const {
+    key_comparisons++;
+    switch (n->type) {
+    case NODE4: {
+        Node4* p = static_cast<Node4*>(n);
+        for (int i = 0; i < n->num_children; i++)
+            if (p->keys[i] == c) return &p->children[i];
+        return nullptr;
+    }
+    case NODE16: {
+        Node16* p = static_cast<Node16*>(n);
+#ifdef __SSE2__
+        __m128i cmp = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(c)),
+                                     _mm_loadu_si128(reinterpret_cast<const __m128i*>(p->keys)));
+        unsigned bits = static_cast<unsigned>(_mm_movemask_epi8(cmp)) & ((1u << n->num_children) - 1);
+        if (bits) return &p->children[__builtin_ctz(bits)];
+#else
+        for (int i = 0; i < n->num_children; i++)
+            if (p->keys[i] == c) return &p->children[i];
+#endif
+        return nullptr;
+    }
+    case NODE48: {
+        Node48* p = static_cast<Node48*>(n);
+        if (p->index[c]) return &p->children[p->index[c] - 1];
+        return nullptr;
+    }
+    case NODE256: {
+        Node256* p = static_cast<Node256*>(n);
+        if (p->children[c]) return &p->children[c];
+        return nullptr;
+    }
+    }
+    return nullptr;
+}
+
+template <typename Key, typename Value>
+void ART<Key, Value>::add_child(void*& ref, Inner* n, unsigned char c, void* child) {
+    switch (n->type) {
+    case NODE4: {
+        Node4* p = static_cast<Node4*>(n);
+        if (n->num_children < 4) {
+            int pos = 0;
+            while (pos < n->num_children && p->keys[pos] < c) pos++;
+            std::memmove(p->keys + pos + 1, p->keys + pos, n->num_children - pos);
+            std::memmove(p->children + pos + 1, p->children + pos, (n->num_children - pos) * sizeof(void*));
+            p->keys[pos] = c;
+            p->children[pos] = child;
+            n->num_children++;
+            return;
+        }
+        Node16* g = new Node16();
+        copy_header(g, n);
+        g->type = NODE16;
+        std::memcpy(g->keys, p->keys, 4);
+        std::memcpy(g->children, p->children, 4 * sizeof(void*));
+        ref = g;
+        delete p;
+        add_child(ref, g, c, child);
+        return;
+    }
+    case NODE16: {
+        Node16* p = static_cast<Node16*>(n);
+        if (n->num_children < 16) {
+            int pos = 0;
+            while (pos < n->num_children && p->keys[pos] < c) pos++;
+            std::memmove(p->keys + pos + 1, p->keys + pos, n->num_children - pos);
+            std::memmove(p->children + pos + 1, p->children + pos, (n->num_children - pos) * sizeof(void*));
+            p->keys[pos] = c;
+            p->children[pos] = child;
+            n->num_children++;
+            return;
+        }
+        Node48* g = new Node48();
+        copy_header(g, n);
+        g->type = NODE48;
+        for (int i = 0; i < 16; i++) {
+            g->children[i] = p->children[i];
+            g->index[p->keys[i]] = static_cast<unsigned char>(i + 1);
+        }
+        ref = g;
+        delete p;
+        add_child(ref, g, c, child);
+        return;
+    }
+    case NODE48: {
+        Node48* p = static_cast<Node48*>(n);
+        if (n->num_children < 48) {
+            int pos = 0;
+            while (p->children[pos] != nullptr) pos++;
+            p->children[pos] = child;
+            p->index[c] = static_cast<unsigned char>(pos + 1);
+            n->num_children++;
+            return;
+        }
+        Node256* g = new Node256();
+        copy_header(g, n);
+        g->type = NODE256;
+        for (int i = 0; i < 256; i++)
+            if (p->index[i]) g->children[i] = p->children[p->index[i] - 1];
+        ref = g;
+        delete p;
+        add_child(ref, g, c, child);
+        return;
+    }
+    case NODE256: {
+        Node256* p = static_cast<Node256*>(n);
+        p->children[c] = child;
+        n->num_children++;
+        return;
+    }
+    }
+}
+
+template <typename Key, typename Value>
+void ART<Key, Value>::remove_child(void*& ref, Inner* n, unsigned char c, void** slot) {
+    switch (n->type) {
+    case NODE4: {
+        Node4* p = static_cast<Node4*>(n);
+        int pos = static_cast<int>(slot - p->children);
+        std::memmove(p->keys + pos, p->keys + pos + 1, n->num_children - 1 - pos);
+        std::memmove(p->children + pos, p->children + pos + 1, (n->num_children - 1 - pos) * sizeof(void*));
+        n->num_children--;
+        collapse(ref, n);
+        return;
+    }
+    case NODE16: {
+        Node16* p = static_cast<Node16*>(n);
+        int pos = static_cast<int>(slot - p->children);
+        std::memmove(p->keys + pos, p->keys + pos + 1, n->num_children - 1 - pos);
+        std::memmove(p->children + pos, p->children + pos + 1, (n->num_children - 1 - pos) * sizeof(void*));
+        n->num_children--;
+        if (n->num_children == 3) {
+            Node4* s = new Node4();
+            copy_header(s, n);
+            s->type = NODE4;
+            std::memcpy(s->keys, p->keys, 3);
+            std::memcpy(s->children, p->children, 3 * sizeof(void*));
+            ref = s;
+            delete p;
+        }
+        return;
+    }
+    case NODE48: {
+        Node48* p = static_cast<Node48*>(n);
+        p->children[p->index[c] - 1] = nullptr;
+        p->index[c] = 0;
+        n->num_children--;
+        if (n->num_children == 12) {
+            Node16* s = new Node16();
+            copy_header(s, n);
+            s->type = NODE16;
+            int j = 0;
+            for (int i = 0; i < 256; i++) {
+                if (p->index[i]) {
+                    s->keys[j] = static_cast<unsigned char>(i);
+                    s->children[j] = p->children[p->index[i] - 1];
+                    j++;
+                }
+            }
+            ref = s;
+            delete p;
+        }
+        return;
+    }
+    case NODE256: {
+        Node256* p = static_cast<Node256*>(n);
+        p->children[c] = nullptr;
+        n->num_children--;
+        if (n->num_children == 37) {
+            Node48* s = new Node48();
+            copy_header(s, n);
+            s->type = NODE48;
+            int j = 0;
+            for (int i = 0; i < 256; i++) {
+                if (p->children[i]) {
+                    s->children[j] = p->children[i];
+                    s->index[i] = static_cast<unsigned char>(j + 1);
+                    j++;
+                }
+            }
+            ref = s;
+            delete p;
+        }
+        return;
+    }
+    }
+}
+
+// Um Node4 que ficou com um único caminho deixa de ramificar: ou vira a
+// própria folha restante, ou é fundido ao filho concatenando os prefixos
+template <typename Key, typename Value>
+void ART<Key, Value>::collapse(void*& ref, Inner* n) {
+    if (n->type != NODE4) return;
+    Node4* p = static_cast<Node4*>(n);
+
+    if (n->num_children == 0) {
+        ref = n->terminal ? tag(n->terminal) : nullptr;
+        delete p;
+        return;
+    }
+    if (n->num_children != 1 || n->terminal != nullptr) return;
+
+    void* child = p->children[0];
+    if (!is_leaf(child)) {
+        Inner* c = static_cast<Inner*>(child);
+        unsigned char merged[MAX_PREFIX];
+        uint32_t len = std::min(n->prefix_len, MAX_PREFIX);
+        std::memcpy(merged, n->prefix, len);
+        if (len < MAX_PREFIX) merged[len++] = p->keys[0];
+        uint32_t extra = std::min(c->prefix_len, MAX_PREFIX - len);
+        std::memcpy(merged + len, c->prefix, extra);
+        c->prefix_len += n->prefix_len + 1;
+        std::memcpy(c->prefix, merged, len + extra);
+    }
+    ref = child;
+    delete p;
+}
+
+template <typename Key, typename Value>
+uint32_t ART<Key, Value>::check_prefix(const Inner* n, const Key& k, size_t depth) const {
+    uint32_t max_cmp = static_cast<uint32_t>(std::min<size_t>(std::min(n->prefix_len, MAX_PREFIX), k.size() - depth));
+    uint32_t i = 0;
+    while (i < max_cmp && n->prefix[i] == static_cast<unsigned char>(k[depth + i])) i++;
+    return i;
+}
+
+// Quantos bytes do prefixo comprimido casam com a chave a partir de depth
+// (exato, mesmo quando o prefixo excede MAX_PREFIX)
+template <typename Key, typename Value>
+uint32_t ART<Key, Value>::prefix_mismatch(const Inner* n, const Key& k, size_t depth) const {
+    uint32_t i = check_prefix(n, k, depth);
+    if (i < std::min(n->prefix_len, MAX_PREFIX) || n->prefix_len <= MAX_PREFIX) return i;
+
+    const Leaf* min = minimum(n);
+    size_t max_cmp = std::min<size_t>(n->prefix_len, k.size() - depth);
+    while (i < max_cmp && min->key[depth + i] == k[depth + i]) i++;
+    return i;
+}
+
+template <typename Key, typename Value>
+typename ART<Key, Value>::Leaf* ART<Key, Value>::minimum(const void* p) const {
+    while (p != nullptr && !is_leaf(p)) {
+        const Inner* n = static_cast<const Inner*>(p);
+        if (n->terminal) return n->terminal;
+        switch (n->type) {
+        case NODE4: p = static_cast<const Node4*>(n)->children[0]; break;
+        case NODE16: p = static_cast<const Node16*>(n)->children[0]; break;
+        case NODE48: {
+            const Node48* q = static_cast<const Node48*>(n);
+            int i = 0;
+            while (!q->index[i]) i++;
+            p = q->children[q->index[i] - 1];
+            break;
+        }
+        case NODE256: {
+            const Node256* q = static_cast<const Node256*>(n);
+            int i = 0;
+            while (!q->children[i]) i++;
+            p = q->children[i];
+            break;
+        }
+        }
+    }
+    return p ? as_leaf(p) : nullptr;
+}
+
+template <typename Key, typename Value>
+void ART<Key, Value>::copy_header(Inner* dst, const Inner* src) {
+    dst->num_children = src->num_children;
+    dst->prefix_len = src->prefix_len;
+    std::memcpy(dst->prefix, src->prefix, MAX_PREFIX);
+    dst->terminal = src->terminal;
+}
+
+template <typename Key, typename Value>
+void ART<Key, Value>::visit(const void* p, const std::function<void(const Key&, const Value&)>& func) const {
+    if (p == nullptr) return;
+    if (is_leaf(p)) {
+        const Leaf* l = as_leaf(p);
+        func(l->key, l->value);
+        return;
+    }
+    const Inner* n = static_cast<const Inner*>(p);
+    if (n->terminal) func(n->terminal->key, n->terminal->value);
+    switch (n->type) {
+    case NODE4: {
+        const Node4* q = static_cast<const Node4*>(n);
+        for (int i = 0; i < n->num_children; i++) visit(q->children[i], func);
+        break;
+    }
+    case NODE16: {
+        const Node16* q = static_cast<const Node16*>(n);
+        for (int i = 0; i < n->num_children; i++) visit(q->children[i], func);
+        break;
+    }
+    case NODE48: {
+        const Node48* q = static_cast<const Node48*>(n);
+        for (int i = 0; i < 256; i++)
+            if (q->index[i]) visit(q->children[q->index[i] - 1], func);
+        break;
+    }
+    case NODE256: {
+        const Node256* q = static_cast<const Node256*>(n);
+        for (int i = 0; i < 256; i++)
+            if (q->children[i]) visit(q->children[i], func);
+        break;
+    }
+    }
+}
+
+template <typename Key, typename Value>
+void ART<Key, Value>::destroy(void* p) {
+    if (p == nullptr) return;
+    if (is_leaf(p)) {
+        delete as_leaf(p);
+        return;
+    }
+    Inner* n = static_cast<Inner*>(p);
+    delete n->terminal;
+    switch (n->type) {
+    case NODE4: {
+        Node4* q = static_cast<Node4*>(n);
+        for (int i = 0; i < n->num_children; i++) destroy(q->children[i]);
+        delete q;
+        break;
+    }
+    case NODE16: {
+        Node16* q = static_cast<Node16*>(n);
+        for (int i = 0; i < n->num_children; i++) destroy(q->children[i]);
+        delete q;
+        break;
+    }
+    case NODE48: {
+        Node48* q = static_cast<Node48*>(n);
+        for (int i = 0; i < 256; i++)
+            if (q->index[i]) destroy(q->children[q->index[i] - 1]);
+        delete q;
+        break;
+    }
+    case NODE256: {
+        Node256* q = static_cast<Node256*>(n);
+        for (int i = 0; i < 256; i++)
+            if (q->children[i]) destroy(q->children[i]);
+        delete q;
+        break;
+    }
+    }
+}
+
+#endif // ART_HPP
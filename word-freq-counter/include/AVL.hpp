@@ -4,40 +4,94 @@
 #include <iostream>
 #include <algorithm>
 #include <functional>
+#include <iterator>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+#include <thread>
 
 #include "Node.hpp"
+#include "IteratorRange.hpp"
+#include "Stats.hpp"
+#include "NodePool.hpp"
+#include "HotCache.hpp"
 
-template <typename Key, typename Value>
+template <typename Key, typename Value, bool OrderStatistics = false, typename Stats = NoStats>
 class AVL {
 public:
+    class const_iterator;
+    using iterator = const_iterator;
+
     AVL(); 
     void insert(const Key& k); 
+    // Valor de k, inserindo-o com value se ausente, numa só descida
+    Value insert_or_get(const Key& k, const Value& value);
     void update(const Key& key, const Value& new_value);
     Value get(const Key& key) const;
     void remove(const Key& k); 
+    bool decrement(const Key& k);
     bool contains(const Key& k) const; 
-    void forEach(std::function<void(const Key&, const Value&)> func) const;
+    size_t get_batch(const Key* keys, size_t n, Value* out, const Value& missing = Value()) const;
+    size_t contains_batch(const Key* keys, size_t n, bool* out) const;
+    template <typename F>
+    void forEach(F&& func) const;
     int size() const;
     void clear(); 
+
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator lower_bound(const Key& k) const;
+    const_iterator upper_bound(const Key& k) const;
+    IteratorRange<const_iterator> range(const Key& lo, const Key& hi) const;
+
+    // Estatísticas de ordem em O(log n); exigem OrderStatistics = true
+    int rank(const Key& k) const;
+    Key select(int k) const;
+    int count_range(const Key& lo, const Key& hi) const;
+
+    // Cache de chaves quentes na frente da árvore; 0 conjuntos o desliga.
+    // Só insert e insert_or_get o preenchem: get apenas consulta, e leituras
+    // concorrentes de uma árvore pronta continuam seguras
+    void set_hot_cache(size_t sets);
+    HotCacheStats hot_cache_stats() const;
+
+    // Operações de conjunto baseadas em join (Blelloch, Ferizovic e Sun),
+    // que movem nós entre árvores sem realocar nem reinserir.
+    // split: esta árvore fica com as chaves < k e greater (vazia) recebe as
+    // > k; k sai das duas. Devolve se k existia e, se value != nullptr, o valor.
+    bool split(const Key& k, AVL& greater, Value* value = nullptr);
+    // join: esta árvore (vazia) recebe left, a chave k e right, que ficam
+    // vazias; exige chaves de left < k < chaves de right
+    void join(AVL& left, const Key& k, const Value& value, AVL& right);
+    // union_with: move todas as chaves de other para esta árvore, somando
+    // as contagens das chaves em comum com combine(valor daqui, valor de
+    // other). Trabalho O(m log(n/m + 1)); com threads > 1 as duas metades
+    // de cada nível se dividem entre threads (só com NoStats).
+    template <typename Combine>
+    void union_with(AVL& other, Combine combine, unsigned threads = 1);
     
 private:
     Node<Key, Value>* m_root;
     
     int m_size;
     
-    int left_rotates, right_rotates;
-    mutable size_t key_comparisons;
+    mutable Stats m_stats;
+    // Nós removidos são reaproveitados; o pool é compartilhado com as
+    // árvores que trocaram nós com esta por split, join ou union_with
+    std::shared_ptr<NodePool<Node<Key, Value>>> m_pool;
+    std::unique_ptr<HotCache<Key, Value>> m_cache;
+    Node<Key, Value>* m_last;  // nó da chave do último _insert, que não mexe no valor de uma chave já presente
 
 public:
     int height(Node<Key, Value>* node) const; 
+    int subtree_size(Node<Key, Value>* node) const;
     int balance(Node<Key, Value>* node) const; 
     
     void show() const; 
     void print(std::ostream& out = std::cout) const; 
     
     size_t get_comparisons() const; 
-    int get_left_rotations() const; 
-    int get_right_rotations() const; 
+    StatsReport stats() const;
     ~AVL();
 
 private:
@@ -51,30 +105,150 @@ private:
     Node<Key, Value>* right_rotation(Node<Key, Value>* p); 
     Node<Key, Value>* _clear(Node<Key, Value>* node); 
 
+    void update_node(Node<Key, Value>* node);
+    Node<Key, Value>* join_nodes(Node<Key, Value>* l, Node<Key, Value>* m, Node<Key, Value>* r);
+    Node<Key, Value>* join_right(Node<Key, Value>* l, Node<Key, Value>* m, Node<Key, Value>* r);
+    Node<Key, Value>* join_left(Node<Key, Value>* l, Node<Key, Value>* m, Node<Key, Value>* r);
+    void split_nodes(Node<Key, Value>* t, const Key& k, Node<Key, Value>*& l,
+                     Node<Key, Value>*& m, Node<Key, Value>*& r);
+    template <typename Combine>
+    Node<Key, Value>* union_nodes(Node<Key, Value>* a, Node<Key, Value>* b, Combine& combine,
+                                  std::vector<Node<Key, Value>*>& freed, unsigned forks);
+    static int count_nodes(Node<Key, Value>* node);
+
+    static constexpr int PARALLEL_HEIGHT = 10; // subárvores menores unem na mesma thread
+
 private:
     void bshow(Node<Key, Value>* node, std::string heranca) const; 
     void printInOrder(Node<Key, Value>* node, std::ostream& out) const; 
+    const_iterator bound(const Key& k, bool inclusive) const;
+    int count_less(const Key& k, bool inclusive) const;
+    template <typename Emit>
+    size_t lookup_batch(const Key* keys, size_t n, Emit&& emit) const;
+
+    static constexpr size_t BATCH_GROUP = 8; // descidas intercaladas por lote
+};
+
+// Iterador bidirecional em ordem. A AVL não mantém ponteiro para o pai,
+// então o iterador guarda o caminho da raiz até o nó corrente.
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+class AVL<Key, Value, OrderStatistics, Stats>::const_iterator {
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Node<Key, Value>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Node<Key, Value>*;
+    using reference = const Node<Key, Value>&;
+
+    const_iterator() : m_root(nullptr) {}
+
+    reference operator*() const { return *m_path.back(); }
+    pointer operator->() const { return m_path.back(); }
+
+    const_iterator& operator++() {
+        Node<Key, Value>* node = m_path.back();
+        if (node->right != nullptr) {
+            descend(node->right, true);
+            return *this;
+        }
+        // Sobe até chegar vindo de um filho esquerdo
+        Node<Key, Value>* child;
+        do {
+            child = m_path.back();
+            m_path.pop_back();
+        } while (!m_path.empty() && m_path.back()->left != child);
+        return *this;
+    }
+
+    const_iterator& operator--() {
+        if (m_path.empty()) {
+            if (m_root != nullptr) descend(m_root, false);
+            return *this;
+        }
+        Node<Key, Value>* node = m_path.back();
+        if (node->left != nullptr) {
+            descend(node->left, false);
+            return *this;
+        }
+        Node<Key, Value>* child;
+        do {
+            child = m_path.back();
+            m_path.pop_back();
+        } while (!m_path.empty() && m_path.back()->right != child);
+        return *this;
+    }
+
+    const_iterator operator++(int) { const_iterator tmp = *this; ++*this; return tmp; }
+    const_iterator operator--(int) { const_iterator tmp = *this; --*this; return tmp; }
+
+    bool operator==(const const_iterator& other) const { return current() == other.current(); }
+    bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+private:
+    friend class AVL<Key, Value, OrderStatistics, Stats>;
+
+    Node<Key, Value>* m_root;
+    std::vector<Node<Key, Value>*> m_path;
+
+    explicit const_iterator(Node<Key, Value>* root) : m_root(root) {}
+
+    Node<Key, Value>* current() const { return m_path.empty() ? nullptr : m_path.back(); }
+
+    // Empilha node e segue sempre para a esquerda (mínimo) ou direita (máximo)
+    void descend(Node<Key, Value>* node, bool leftmost) {
+        while (node != nullptr) {
+            m_path.push_back(node);
+            node = leftmost ? node->left : node->right;
+        }
+    }
 };
 
-template <typename Key, typename Value>
-AVL<Key, Value>::AVL(){
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+AVL<Key, Value, OrderStatistics, Stats>::AVL(){
     m_root = nullptr;
-    m_size = left_rotates = right_rotates = key_comparisons = 0;
-    std::cout << "dicionário construído com valores padrão" << std::endl;
+    m_size = 0;
+    m_last = nullptr;
+    m_pool = std::make_shared<NodePool<Node<Key, Value>>>();
+    m_stats.log("dicionário construído com valores padrão");
 }
 
-template <typename Key, typename Value>
-AVL<Key, Value>::~AVL(){
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+AVL<Key, Value, OrderStatistics, Stats>::~AVL(){
     clear();
 }
 
-template <typename Key, typename Value>
-void AVL<Key, Value>::insert(const Key& key){
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+void AVL<Key, Value, OrderStatistics, Stats>::insert(const Key& key){
+    size_t h = 0;
+    if (m_cache) {
+        h = m_cache->hash(key);
+        if (Value* value = m_cache->find(key, h)) {
+            ++*value;
+            return;
+        }
+    }
+    int before = m_size;
+    m_root = _insert(m_root, key);
+    if (m_size == before) m_last->value++;
+    if (m_cache) m_cache->put(h, &m_last->key, &m_last->value);
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+Value AVL<Key, Value, OrderStatistics, Stats>::insert_or_get(const Key& key, const Value& value) {
+    size_t h = 0;
+    if (m_cache) {
+        h = m_cache->hash(key);
+        if (Value* found = m_cache->find(key, h)) return *found;
+    }
+    int before = m_size;
     m_root = _insert(m_root, key);
+    if (m_size != before) m_last->value = value;
+    if (m_cache) m_cache->put(h, &m_last->key, &m_last->value);
+    return m_last->value;
 }
 
-template <typename Key, typename Value>
-void AVL<Key, Value>::update(const Key& key, const Value& new_value) {
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+void AVL<Key, Value, OrderStatistics, Stats>::update(const Key& key, const Value& new_value) {
     Node<Key, Value>* node = m_root;
     while (node != nullptr) {
         if (key == node->key) {
@@ -89,12 +263,15 @@ void AVL<Key, Value>::update(const Key& key, const Value& new_value) {
     throw std::runtime_error("Chave não encontrada para atualização");
 }
 
-template <typename Key, typename Value>
-Value AVL<Key, Value>::get(const Key& key) const {
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+Value AVL<Key, Value, OrderStatistics, Stats>::get(const Key& key) const {
+    if (m_cache) {
+        const HotCache<Key, Value>& cache = *m_cache;
+        if (const Value* value = cache.peek(key, cache.hash(key))) return *value;
+    }
     Node<Key, Value>* node = m_root;
     while (node != nullptr) {
-        if (key == node->key)
-            return node->value;
+        if (key == node->key) return node->value;
         else if (key < node->key)
             node = node->left;
         else
@@ -103,89 +280,291 @@ Value AVL<Key, Value>::get(const Key& key) const {
     throw std::runtime_error("Chave não encontrada");
 }
 
-template <typename Key, typename Value>
-void AVL<Key, Value>::remove(const Key& key){
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+void AVL<Key, Value, OrderStatistics, Stats>::remove(const Key& key){
     m_root = _remove(m_root, key);
-    std::cout << "chave " << key << " removida" << std::endl;
+    m_stats.log("chave ", key, " removida");
 }
 
-template <typename Key, typename Value>
-bool AVL<Key, Value>::contains(const Key& k) const {
+// Tira uma ocorrência da chave; ao chegar a zero, remove o nó.
+// Devolve true quando a chave saiu do dicionário.
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+bool AVL<Key, Value, OrderStatistics, Stats>::decrement(const Key& k) {
+    Node<Key, Value>* node = _contains(m_root, k);
+    if (node == nullptr) return false;
+    if (node->value > 1) {
+        node->value--;
+        return false;
+    }
+    m_root = _remove(m_root, k);
+    return true;
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+bool AVL<Key, Value, OrderStatistics, Stats>::contains(const Key& k) const {
     return _contains(m_root, k) != nullptr;
 }
 
-template <typename Key, typename Value>
-void AVL<Key, Value>::forEach(std::function<void(const Key&, const Value&)> func) const {
-    std::function<void(Node<Key, Value>*)> inOrder = [&](Node<Key, Value>* node) {
-        if (node == nullptr) return;
-        inOrder(node->left);
+// Percurso em ordem iterativo: sem std::function e sem recursão
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+template <typename F>
+void AVL<Key, Value, OrderStatistics, Stats>::forEach(F&& func) const {
+    std::vector<Node<Key, Value>*> stack;
+    stack.reserve(height(m_root));
+    Node<Key, Value>* node = m_root;
+    while (node != nullptr || !stack.empty()) {
+        while (node != nullptr) {
+            stack.push_back(node);
+            node = node->left;
+        }
+        node = stack.back();
+        stack.pop_back();
         func(node->key, node->value);
-        inOrder(node->right);
-    };
-    inOrder(m_root);
+        node = node->right;
+    }
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+size_t AVL<Key, Value, OrderStatistics, Stats>::get_batch(const Key* keys, size_t n, Value* out, const Value& missing) const {
+    return lookup_batch(keys, n, [&](size_t i, const Node<Key, Value>* node) {
+        out[i] = node ? node->value : missing;
+    });
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+size_t AVL<Key, Value, OrderStatistics, Stats>::contains_batch(const Key* keys, size_t n, bool* out) const {
+    return lookup_batch(keys, n, [&](size_t i, const Node<Key, Value>* node) {
+        out[i] = node != nullptr;
+    });
+}
+
+// Prefetch em grupo: BATCH_GROUP descidas avançam um nível por vez, em
+// sequência, e o filho de cada uma é pedido com prefetch antes de voltar a
+// ela. Assim as faltas de cache das buscas independentes se sobrepõem.
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+template <typename Emit>
+size_t AVL<Key, Value, OrderStatistics, Stats>::lookup_batch(const Key* keys, size_t n, Emit&& emit) const {
+    Node<Key, Value>* cur[BATCH_GROUP];
+    size_t idx[BATCH_GROUP];
+    size_t found = 0;
+    for (size_t base = 0; base < n; base += BATCH_GROUP) {
+        size_t active = std::min(BATCH_GROUP, n - base);
+        for (size_t j = 0; j < active; j++) {
+            cur[j] = m_root;
+            idx[j] = base + j;
+        }
+        while (active > 0) {
+            for (size_t j = 0; j < active;) {
+                Node<Key, Value>* node = cur[j];
+                const Key& k = keys[idx[j]];
+                Node<Key, Value>* next = nullptr;
+                bool hit = false;
+                bool done = node == nullptr;
+                if (!done) {
+                    m_stats.comparison();
+                    if (k == node->key) {
+                        hit = done = true;
+                    } else {
+                        next = k < node->key ? node->left : node->right;
+                        if (next == nullptr) done = true;
+                    }
+                }
+                if (done) {
+                    if (hit) found++;
+                    emit(idx[j], hit ? node : nullptr);
+                    // Fecha o buraco trazendo a última descida ativa para j
+                    active--;
+                    cur[j] = cur[active];
+                    idx[j] = idx[active];
+                    continue;
+                }
+                __builtin_prefetch(next);
+                cur[j] = next;
+                j++;
+            }
+        }
+    }
+    return found;
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+typename AVL<Key, Value, OrderStatistics, Stats>::const_iterator AVL<Key, Value, OrderStatistics, Stats>::begin() const {
+    const_iterator it(m_root);
+    it.m_path.reserve(height(m_root));
+    it.descend(m_root, true);
+    return it;
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+typename AVL<Key, Value, OrderStatistics, Stats>::const_iterator AVL<Key, Value, OrderStatistics, Stats>::end() const {
+    return const_iterator(m_root);
+}
+
+// Primeira chave >= k
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+typename AVL<Key, Value, OrderStatistics, Stats>::const_iterator AVL<Key, Value, OrderStatistics, Stats>::lower_bound(const Key& k) const {
+    return bound(k, true);
+}
+
+// Primeira chave > k
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+typename AVL<Key, Value, OrderStatistics, Stats>::const_iterator AVL<Key, Value, OrderStatistics, Stats>::upper_bound(const Key& k) const {
+    return bound(k, false);
+}
+
+// Chaves no intervalo fechado [lo, hi]
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+IteratorRange<typename AVL<Key, Value, OrderStatistics, Stats>::const_iterator> AVL<Key, Value, OrderStatistics, Stats>::range(const Key& lo, const Key& hi) const {
+    if (hi < lo) return {end(), end()};
+    return {lower_bound(lo), upper_bound(hi)};
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+int AVL<Key, Value, OrderStatistics, Stats>::rank(const Key& k) const {
+    static_assert(OrderStatistics, "rank exige AVL com OrderStatistics = true");
+    return count_less(k, false);
+}
+
+// k-ésima menor chave, contando a partir de 0
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+Key AVL<Key, Value, OrderStatistics, Stats>::select(int k) const {
+    static_assert(OrderStatistics, "select exige AVL com OrderStatistics = true");
+    if (k < 0 || k >= m_size) throw std::out_of_range("posição inválida");
+    Node<Key, Value>* node = m_root;
+    while (true) {
+        int left = subtree_size(node->left);
+        if (k < left) {
+            node = node->left;
+        } else if (k == left) {
+            return node->key;
+        } else {
+            k -= left + 1;
+            node = node->right;
+        }
+    }
+}
+
+// Quantidade de chaves distintas em [lo, hi]
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+int AVL<Key, Value, OrderStatistics, Stats>::count_range(const Key& lo, const Key& hi) const {
+    static_assert(OrderStatistics, "count_range exige AVL com OrderStatistics = true");
+    if (hi < lo) return 0;
+    return count_less(hi, true) - count_less(lo, false);
+}
+
+// Chaves < k (ou <= k quando inclusive)
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+int AVL<Key, Value, OrderStatistics, Stats>::count_less(const Key& k, bool inclusive) const {
+    int count = 0;
+    Node<Key, Value>* node = m_root;
+    while (node != nullptr) {
+        m_stats.comparison();
+        if (inclusive ? k < node->key : !(node->key < k)) {
+            node = node->left;
+        } else {
+            count += subtree_size(node->left) + 1;
+            node = node->right;
+        }
+    }
+    return count;
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+typename AVL<Key, Value, OrderStatistics, Stats>::const_iterator AVL<Key, Value, OrderStatistics, Stats>::bound(const Key& k, bool inclusive) const {
+    const_iterator it(m_root);
+    it.m_path.reserve(height(m_root));
+    size_t candidate = 0; // tamanho do caminho até o melhor candidato (0 = nenhum)
+    Node<Key, Value>* node = m_root;
+    while (node != nullptr) {
+        it.m_path.push_back(node);
+        m_stats.comparison();
+        if (inclusive ? !(node->key < k) : k < node->key) {
+            candidate = it.m_path.size();
+            node = node->left;
+        } else {
+            node = node->right;
+        }
+    }
+    it.m_path.resize(candidate);
+    return it;
 }
 
-template <typename Key, typename Value>
-int AVL<Key, Value>::size() const {
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+int AVL<Key, Value, OrderStatistics, Stats>::size() const {
     return m_size;
 }
 
-template <typename Key, typename Value>
-void AVL<Key, Value>::clear(){
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+void AVL<Key, Value, OrderStatistics, Stats>::clear(){
+    if (m_cache) m_cache->clear();
     m_root = _clear(m_root);
     m_size = 0;
+    m_stats.log("Limpeza concluída.");
 }
 
-template <typename Key, typename Value>
-void AVL<Key, Value>::print(std::ostream& out) const{
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+void AVL<Key, Value, OrderStatistics, Stats>::print(std::ostream& out) const{
     printInOrder(m_root, out);
 }
 
-template <typename Key, typename Value>
-int AVL<Key, Value>::height(Node<Key, Value>* node) const {
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+int AVL<Key, Value, OrderStatistics, Stats>::height(Node<Key, Value>* node) const {
     if (node == nullptr) return 0;
     return node->height;
 }
 
-template <typename Key, typename Value>
-int AVL<Key, Value>::balance(Node<Key, Value>* node) const {
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+int AVL<Key, Value, OrderStatistics, Stats>::subtree_size(Node<Key, Value>* node) const {
+    if (node == nullptr) return 0;
+    return node->size;
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+int AVL<Key, Value, OrderStatistics, Stats>::balance(Node<Key, Value>* node) const {
     if (node == nullptr) return 0;
     return height(node->right) - height(node->left);
 }
 
-template <typename Key, typename Value>
-void AVL<Key, Value>::show() const {
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+void AVL<Key, Value, OrderStatistics, Stats>::show() const {
     bshow(m_root, "");
 }
 
-template <typename Key, typename Value>
-size_t AVL<Key, Value>::get_comparisons() const{
-    return key_comparisons;
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+size_t AVL<Key, Value, OrderStatistics, Stats>::get_comparisons() const{
+    return m_stats.report().comparisons;
 }
 
-template <typename Key, typename Value>
-int AVL<Key, Value>::get_left_rotations() const{
-    return left_rotates;
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+void AVL<Key, Value, OrderStatistics, Stats>::set_hot_cache(size_t sets) {
+    m_cache.reset(sets > 0 ? new HotCache<Key, Value>(sets) : nullptr);
 }
 
-template <typename Key, typename Value>
-int AVL<Key, Value>::get_right_rotations() const{
-    return right_rotates;
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+HotCacheStats AVL<Key, Value, OrderStatistics, Stats>::hot_cache_stats() const {
+    return m_cache ? m_cache->stats() : HotCacheStats();
 }
 
-template <typename Key, typename Value>
-Node<Key, Value>* AVL<Key, Value>::_insert(Node<Key, Value>* node, const Key& k){
+// Contadores da política Stats (todos zero com NoStats)
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+StatsReport AVL<Key, Value, OrderStatistics, Stats>::stats() const{
+    return m_stats.report();
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+Node<Key, Value>* AVL<Key, Value, OrderStatistics, Stats>::_insert(Node<Key, Value>* node, const Key& k){
     if (node == nullptr){ 
         m_size++;
-        return new Node<Key, Value>(k, 1, 1, nullptr, nullptr);
+        m_last = m_pool->acquire(k, 1, 1, nullptr, nullptr);
+        return m_last;
     }
-    key_comparisons++; 
+    m_stats.comparison(); 
     if (k == node->key) {
-        node->value++;
+        m_last = node;
         return node;
     }
 
-    key_comparisons++; 
+    m_stats.comparison(); 
     if (k < node->key) {
         node->left = _insert(node->left, k);
     } else {
@@ -195,15 +574,15 @@ Node<Key, Value>* AVL<Key, Value>::_insert(Node<Key, Value>* node, const Key& k)
     return fixup_node(node);
 }
 
-template <typename Key, typename Value>
-Node<Key, Value>* AVL<Key, Value>::_remove(Node<Key, Value>* node, const Key& k) {
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+Node<Key, Value>* AVL<Key, Value, OrderStatistics, Stats>::_remove(Node<Key, Value>* node, const Key& k) {
     if (node == nullptr) return nullptr;
 
-    key_comparisons++;
+    m_stats.comparison();
     if (k < node->key) {
         node->left = _remove(node->left, k);
     } else {
-        key_comparisons++;
+        m_stats.comparison();
         if (k > node->key) {
             node->right = _remove(node->right, k);
         } else {
@@ -218,10 +597,13 @@ Node<Key, Value>* AVL<Key, Value>::_remove(Node<Key, Value>* node, const Key& k)
     return fixup_node(node);
 }
 
-template <typename Key, typename Value>
-Node<Key, Value>* AVL<Key, Value>::_remove_node(Node<Key, Value>* node) {
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+Node<Key, Value>* AVL<Key, Value, OrderStatistics, Stats>::_remove_node(Node<Key, Value>* node) {
+    // O nó perde a chave, e o conteúdo de temp ou do sucessor muda de nó
+    if (m_cache) m_cache->invalidate(node->key);
     if (node->left == nullptr || node->right == nullptr) {
         Node<Key, Value>* temp = node->left ? node->left : node->right;
+        if (m_cache && temp != nullptr) m_cache->invalidate(temp->key);
         
         if (temp == nullptr) {
             temp = node;
@@ -230,7 +612,8 @@ Node<Key, Value>* AVL<Key, Value>::_remove_node(Node<Key, Value>* node) {
             *node = *temp; // Copia os dados do filho não-nulo
         }
         
-        delete temp;
+        m_pool->release(temp);
+        m_size--;
     } else {
         Node<Key, Value>* succ = node->right;
         while (succ->left != nullptr) {
@@ -245,16 +628,16 @@ Node<Key, Value>* AVL<Key, Value>::_remove_node(Node<Key, Value>* node) {
     return node;
 }
 
-template <typename Key, typename Value>
-Node<Key, Value>* AVL<Key, Value>::_contains(Node<Key, Value>* node, const Key& k) const{
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+Node<Key, Value>* AVL<Key, Value, OrderStatistics, Stats>::_contains(Node<Key, Value>* node, const Key& k) const{
     if (node == nullptr) return nullptr;
 
-    key_comparisons++;
+    m_stats.comparison();
     if (node->key == k) {
         return node;
     }
 
-    key_comparisons++;
+    m_stats.comparison();
     if (k < node->key) {
         return _contains(node->left, k);
     } else {
@@ -262,10 +645,12 @@ Node<Key, Value>* AVL<Key, Value>::_contains(Node<Key, Value>* node, const Key&
     }
 }
 
-template <typename Key, typename Value>
-Node<Key, Value>*AVL<Key, Value>::fixup_node(Node<Key, Value>* node) {
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+Node<Key, Value>*AVL<Key, Value, OrderStatistics, Stats>::fixup_node(Node<Key, Value>* node) {
     // Atualiza altura primeiro
     node->height = 1 + std::max(height(node->left), height(node->right));
+    if constexpr (OrderStatistics)
+        node->size = 1 + subtree_size(node->left) + subtree_size(node->right);
     
     int bal = balance(node);
 
@@ -294,42 +679,49 @@ Node<Key, Value>*AVL<Key, Value>::fixup_node(Node<Key, Value>* node) {
     return node;
 }
 
-template <typename Key, typename Value>
-Node<Key, Value>* AVL<Key, Value>::left_rotation(Node<Key, Value>* p){
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+Node<Key, Value>* AVL<Key, Value, OrderStatistics, Stats>::left_rotation(Node<Key, Value>* p){
     Node<Key, Value>* u = p->right;
     p->right = u->left;
     u->left = p;
     p->height = 1 + std::max(height(p->left), height(p->right));
     u->height = 1 + std::max(height(u->left), height(u->right));
-    left_rotates++;
+    if constexpr (OrderStatistics) {
+        u->size = p->size;
+        p->size = 1 + subtree_size(p->left) + subtree_size(p->right);
+    }
+    m_stats.rotation();
     return u;
 }
 
-template <typename Key, typename Value>
-Node<Key, Value>* AVL<Key, Value>::right_rotation(Node<Key, Value>* p){
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+Node<Key, Value>* AVL<Key, Value, OrderStatistics, Stats>::right_rotation(Node<Key, Value>* p){
     Node<Key, Value>* u = p->left;
     p->left = u->right;
     u->right = p;
     p->height = 1 + std::max(height(p->left), height(p->right));
     u->height = 1 + std::max(height(u->left), height(u->right));
-    right_rotates++;
+    if constexpr (OrderStatistics) {
+        u->size = p->size;
+        p->size = 1 + subtree_size(p->left) + subtree_size(p->right);
+    }
+    m_stats.rotation();
     return u;
 }
 
-template <typename Key, typename Value>
-Node<Key, Value>* AVL<Key, Value>::_clear(Node<Key, Value>* node){
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+Node<Key, Value>* AVL<Key, Value, OrderStatistics, Stats>::_clear(Node<Key, Value>* node){
     if (node != nullptr) {
         node->left = _clear(node->left);
         node->right = _clear(node->right);
-        delete node;
+        m_pool->release(node);
     }
 
     return nullptr; 
-    std::cout << "Limpeza concluída." << std::endl;
 }
 
-template <typename Key, typename Value>
-void AVL<Key, Value>::bshow(Node<Key, Value>* node, std::string heranca) const{
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+void AVL<Key, Value, OrderStatistics, Stats>::bshow(Node<Key, Value>* node, std::string heranca) const{
     if(node != nullptr && (node->left != nullptr || node->right != nullptr))
         bshow(node->right, heranca + "r");
     for(int i = 0; i < (int) heranca.size() - 1; i++)
@@ -345,8 +737,223 @@ void AVL<Key, Value>::bshow(Node<Key, Value>* node, std::string heranca) const{
         bshow(node->left, heranca + "l");
 }
 
-template <typename Key, typename Value>
-void AVL<Key, Value>::printInOrder(Node<Key, Value>* node, std::ostream& out) const{
+// Recalcula altura e tamanho a partir dos filhos
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+void AVL<Key, Value, OrderStatistics, Stats>::update_node(Node<Key, Value>* node) {
+    node->height = 1 + std::max(height(node->left), height(node->right));
+    if constexpr (OrderStatistics)
+        node->size = 1 + subtree_size(node->left) + subtree_size(node->right);
+}
+
+// Junta l, m e r (chaves de l < m < chaves de r) numa AVL em
+// O(|altura(l) - altura(r)|): desce pela espinha da mais alta até uma
+// subárvore da altura da outra, pendura m ali e rebalanceia na volta
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+Node<Key, Value>* AVL<Key, Value, OrderStatistics, Stats>::join_nodes(Node<Key, Value>* l, Node<Key, Value>* m,
+                                                                      Node<Key, Value>* r) {
+    if (height(l) > height(r) + 1) return join_right(l, m, r);
+    if (height(r) > height(l) + 1) return join_left(l, m, r);
+    m->left = l;
+    m->right = r;
+    update_node(m);
+    return m;
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+Node<Key, Value>* AVL<Key, Value, OrderStatistics, Stats>::join_right(Node<Key, Value>* l, Node<Key, Value>* m,
+                                                                      Node<Key, Value>* r) {
+    Node<Key, Value>* c = l->right;
+    if (height(c) <= height(r) + 1) {
+        m->left = c;
+        m->right = r;
+        update_node(m);
+        if (height(m) <= height(l->left) + 1) {
+            l->right = m;
+            update_node(l);
+            return l;
+        }
+        l->right = right_rotation(m);
+        update_node(l);
+        return left_rotation(l);
+    }
+    l->right = join_right(c, m, r);
+    update_node(l);
+    if (height(l->right) <= height(l->left) + 1) return l;
+    return left_rotation(l);
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+Node<Key, Value>* AVL<Key, Value, OrderStatistics, Stats>::join_left(Node<Key, Value>* l, Node<Key, Value>* m,
+                                                                     Node<Key, Value>* r) {
+    Node<Key, Value>* c = r->left;
+    if (height(c) <= height(l) + 1) {
+        m->left = l;
+        m->right = c;
+        update_node(m);
+        if (height(m) <= height(r->right) + 1) {
+            r->left = m;
+            update_node(r);
+            return r;
+        }
+        r->left = left_rotation(m);
+        update_node(r);
+        return right_rotation(r);
+    }
+    r->left = join_left(l, m, c);
+    update_node(r);
+    if (height(r->left) <= height(r->right) + 1) return r;
+    return right_rotation(r);
+}
+
+// Separa t em l (< k), o nó de k em m (ou nullptr) e r (> k), em O(log n)
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+void AVL<Key, Value, OrderStatistics, Stats>::split_nodes(Node<Key, Value>* t, const Key& k, Node<Key, Value>*& l,
+                                                          Node<Key, Value>*& m, Node<Key, Value>*& r) {
+    if (t == nullptr) {
+        l = m = r = nullptr;
+        return;
+    }
+    Node<Key, Value>* left = t->left;
+    Node<Key, Value>* right = t->right;
+    if (k == t->key) {
+        l = left;
+        r = right;
+        m = t;
+        m->left = m->right = nullptr;
+        update_node(m);
+    } else if (k < t->key) {
+        Node<Key, Value>* lr;
+        split_nodes(left, k, l, m, lr);
+        r = join_nodes(lr, t, right);
+    } else {
+        Node<Key, Value>* rl;
+        split_nodes(right, k, rl, m, r);
+        l = join_nodes(left, t, rl);
+    }
+}
+
+// União de a e b: b é separada pela chave da raiz de a e as metades se
+// unem recursivamente, em paralelo nos primeiros níveis. Os nós repetidos
+// de b vão para freed, para serem liberados depois numa só thread.
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+template <typename Combine>
+Node<Key, Value>* AVL<Key, Value, OrderStatistics, Stats>::union_nodes(Node<Key, Value>* a, Node<Key, Value>* b,
+                                                                       Combine& combine,
+                                                                       std::vector<Node<Key, Value>*>& freed,
+                                                                       unsigned forks) {
+    if (a == nullptr) return b;
+    if (b == nullptr) return a;
+    Node<Key, Value>* l2;
+    Node<Key, Value>* m2;
+    Node<Key, Value>* r2;
+    split_nodes(b, a->key, l2, m2, r2);
+    Node<Key, Value>* l1 = a->left;
+    Node<Key, Value>* r1 = a->right;
+    if (m2 != nullptr) {
+        a->value = combine(a->value, m2->value);
+        freed.push_back(m2);
+    }
+
+    Node<Key, Value>* l;
+    Node<Key, Value>* r;
+    if (forks > 0 && std::min(height(l1) + height(l2), height(r1) + height(r2)) >= PARALLEL_HEIGHT) {
+        std::vector<Node<Key, Value>*> freedLeft;
+        std::thread worker([&] { l = union_nodes(l1, l2, combine, freedLeft, forks / 2); });
+        r = union_nodes(r1, r2, combine, freed, forks - 1 - forks / 2);
+        worker.join();
+        freed.insert(freed.end(), freedLeft.begin(), freedLeft.end());
+    } else {
+        l = union_nodes(l1, l2, combine, freed, 0);
+        r = union_nodes(r1, r2, combine, freed, 0);
+    }
+    return join_nodes(l, a, r);
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+int AVL<Key, Value, OrderStatistics, Stats>::count_nodes(Node<Key, Value>* node) {
+    int n = 0;
+    std::vector<Node<Key, Value>*> stack;
+    if (node != nullptr) stack.push_back(node);
+    while (!stack.empty()) {
+        node = stack.back();
+        stack.pop_back();
+        n++;
+        if (node->left != nullptr) stack.push_back(node->left);
+        if (node->right != nullptr) stack.push_back(node->right);
+    }
+    return n;
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+bool AVL<Key, Value, OrderStatistics, Stats>::split(const Key& k, AVL& greater, Value* value) {
+    if (&greater == this || greater.m_root != nullptr) {
+        throw std::invalid_argument("split exige uma árvore de destino vazia e distinta");
+    }
+    if (m_cache) m_cache->clear();
+    if (greater.m_cache) greater.m_cache->clear();
+    NodePool<Node<Key, Value>>::merge(m_pool, greater.m_pool);
+
+    Node<Key, Value>* l;
+    Node<Key, Value>* m;
+    Node<Key, Value>* r;
+    split_nodes(m_root, k, l, m, r);
+    m_root = l;
+    greater.m_root = r;
+    // Sem estatísticas de ordem o tamanho de uma das partes tem de ser contado
+    if constexpr (OrderStatistics) greater.m_size = subtree_size(r);
+    else greater.m_size = count_nodes(r);
+    m_size -= greater.m_size + (m != nullptr);
+    if (m == nullptr) return false;
+    if (value != nullptr) *value = m->value;
+    m_pool->release(m);
+    return true;
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+void AVL<Key, Value, OrderStatistics, Stats>::join(AVL& left, const Key& k, const Value& value, AVL& right) {
+    if (m_root != nullptr || &left == this || &right == this || &left == &right) {
+        throw std::invalid_argument("join exige uma árvore de destino vazia e duas origens distintas");
+    }
+    Node<Key, Value>* maxLeft = left.m_root;
+    while (maxLeft != nullptr && maxLeft->right != nullptr) maxLeft = maxLeft->right;
+    Node<Key, Value>* minRight = right.m_root;
+    while (minRight != nullptr && minRight->left != nullptr) minRight = minRight->left;
+    if ((maxLeft != nullptr && !(maxLeft->key < k)) || (minRight != nullptr && !(k < minRight->key))) {
+        throw std::invalid_argument("join exige chaves de left < k < chaves de right");
+    }
+    if (m_cache) m_cache->clear();
+    if (left.m_cache) left.m_cache->clear();
+    if (right.m_cache) right.m_cache->clear();
+    NodePool<Node<Key, Value>>::merge(m_pool, left.m_pool);
+    NodePool<Node<Key, Value>>::merge(m_pool, right.m_pool);
+
+    Node<Key, Value>* m = m_pool->acquire(k, value, 1, nullptr, nullptr);
+    m_root = join_nodes(left.m_root, m, right.m_root);
+    m_size = left.m_size + 1 + right.m_size;
+    left.m_root = right.m_root = nullptr;
+    left.m_size = right.m_size = 0;
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+template <typename Combine>
+void AVL<Key, Value, OrderStatistics, Stats>::union_with(AVL& other, Combine combine, unsigned threads) {
+    if (&other == this || other.m_root == nullptr) return;
+    if (m_cache) m_cache->clear();
+    if (other.m_cache) other.m_cache->clear();
+    NodePool<Node<Key, Value>>::merge(m_pool, other.m_pool);
+
+    // Os contadores de Stats não são atômicos: com eles a união é serial
+    unsigned forks = Stats::enabled ? 0 : std::max(1u, threads) - 1;
+    std::vector<Node<Key, Value>*> freed;
+    m_root = union_nodes(m_root, other.m_root, combine, freed, forks);
+    m_size += other.m_size - static_cast<int>(freed.size());
+    for (Node<Key, Value>* node : freed) m_pool->release(node);
+    other.m_root = nullptr;
+    other.m_size = 0;
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+void AVL<Key, Value, OrderStatistics, Stats>::printInOrder(Node<Key, Value>* node, std::ostream& out) const{
     if (!node) return;
     
     printInOrder(node->left, out);
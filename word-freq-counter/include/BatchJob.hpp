@@ -0,0 +1,29 @@
+#ifndef BATCH_JOB_HPP
+#define BATCH_JOB_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Trecho [begin, end) de um dos arquivos do lote
+struct BatchPiece {
+    size_t file;
+    uint64_t begin;
+    uint64_t end;
+};
+
+// Unidade de trabalho: um pedaço de arquivo grande ou vários arquivos pequenos
+struct BatchTask {
+    std::vector<BatchPiece> pieces;
+    uint64_t bytes;
+};
+
+// Expande arquivos, diretórios (recursivamente) e padrões glob numa lista
+// ordenada e sem repetições de arquivos regulares
+std::vector<std::string> expandInputs(const std::vector<std::string>& inputs);
+
+// Corta arquivos maiores que chunk_bytes em pedaços que terminam entre
+// palavras e junta os menores até ~chunk_bytes; maiores tarefas primeiro
+std::vector<BatchTask> planBatch(const std::vector<std::string>& files, uint64_t chunk_bytes);
+
+#endif
@@ -2,223 +2,527 @@
 #define CHAINED_HASHTABLE_HPP
 
 #include <iostream>
-#include <list>
 #include <vector>
 #include <utility>
 #include <functional>
 #include <stdexcept>
+#include <algorithm>
+
 #include <cmath>
 
-template <typename Key, typename Value, typename Hash = std::hash<Key>>
+#include "HashUtils.hpp"
+#include "NodePool.hpp"
+#include "Stats.hpp"
+
+// Distribuição das chaves pelos baldes, comparada ao esperado para um hash
+// uniforme com o mesmo fator de carga
+struct HashDiagnostics {
+    size_t buckets = 0;
+    size_t elements = 0;
+    std::vector<size_t> histogram;      // histogram[c] = baldes com cadeia de tamanho c
+    size_t max_chain = 0;
+    double load_factor = 0;
+    double expected_probes = 0;         // busca bem-sucedida: 1 + α/2
+    double actual_probes = 0;           // média real de nós visitados por chave
+    double expected_empty = 0;          // fração de baldes vazios: e^-α
+    double actual_empty = 0;
+
+    void print(std::ostream& out) const {
+        out << "baldes: " << buckets << ", chaves: " << elements
+            << ", fator de carga: " << load_factor << '\n'
+            << "cadeia máxima: " << max_chain << '\n'
+            << "sondagens por busca (esperado/real): " << expected_probes
+            << " / " << actual_probes << '\n'
+            << "baldes vazios (esperado/real): " << expected_empty
+            << " / " << actual_empty << '\n'
+            << "histograma (tamanho: baldes):";
+        for (size_t c = 0; c < histogram.size(); c++) {
+            if (histogram[c]) out << ' ' << c << ':' << histogram[c];
+        }
+        out << '\n';
+    }
+};
+
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Stats = NoStats>
 class ChainedHashTable {
 private:
-    std::vector<std::list<std::pair<Key, Value>>> m_table;
+    // Nó intrusivo de lista simples, guardando o hash completo: a chave só
+    // é comparada quando os hashes coincidem, e o rehash não recalcula nada
+    struct HashNode {
+        HashNode* next;
+        size_t hash;
+        Key key;
+        Value value;
+
+        HashNode(HashNode* n, size_t h, const Key& k, const Value& v)
+            : next(n), hash(h), key(k), value(v) {}
+    };
+    using Bucket = HashNode*;
+
+    std::vector<Bucket> m_table;
     size_t m_table_size;
+    FastMod m_mod;
     size_t m_number_of_elements;
     float m_max_load_factor;
     Hash m_hashing;
-    mutable size_t key_comparisons = 0;
+    mutable Stats m_stats;
+
+    // Rehash incremental: enquanto m_old_table não estiver vazia, os baldes
+    // [m_migrated, m_old_size) ainda não foram movidos para m_table
+    bool m_incremental = false;
+    std::vector<Bucket> m_old_table;
+    size_t m_old_size = 0;
+    FastMod m_old_mod;
+    size_t m_migrated = 0;
+
+    NodePool<HashNode> m_pool;
+
+    static constexpr size_t REHASH_STEP = 8;  // baldes migrados por operação
+    static constexpr size_t BATCH_GROUP = 16; // chaves em voo por lote
 
     size_t hash_code(const Key& k) const;
-    size_t get_next_prime(size_t x);
     void rehash(size_t m);
+    void start_rehash(size_t m);
+    void migrate_step(size_t buckets);
+    void finish_rehash();
+    bool rehashing() const;
+    HashNode* find(const Key& k) const;
+    HashNode* find_hashed(size_t h, const Key& k) const;
+    template <typename Emit>
+    size_t lookup_batch(const Key* keys, size_t n, Emit&& emit) const;
+    HashNode* find_in(Bucket b, size_t h, const Key& k) const;
+    void push_new(size_t h, const Key& k, const Value& v);
+    void release_all(std::vector<Bucket>& table);
 
 public:
     ChainedHashTable(size_t tableSize = 19, float load_factor = 1.0);
-    ~ChainedHashTable() = default;
+    ~ChainedHashTable();
+
+    ChainedHashTable(const ChainedHashTable&) = delete;
+    ChainedHashTable& operator=(const ChainedHashTable&) = delete;
 
     bool add(const Key& k, const Value& v);
+    Value insert_or_get(const Key& k, const Value& v);
+    void insert(const Key& k);
     void update(const Key& k, const Value& new_value);
     Value get(const Key& k) const;
     bool remove(const Key& k);
+    bool decrement(const Key& k);
     bool contains(const Key& k) const;
+    size_t get_batch(const Key* keys, size_t n, Value* out, const Value& missing = Value()) const;
+    size_t contains_batch(const Key* keys, size_t n, bool* out) const;
     void forEach(std::function<void(const Key&, const Value&)> func) const;
     void clear();
     size_t size() const;
     size_t bucket_count() const;
-    size_t bucket_size(size_t n) const;
+    size_t bucket_size(size_t n) const;     // durante um rehash incremental, só os nós já migrados
     size_t bucket(const Key& k) const;
     float load_factor() const;
     float max_load_factor() const;
     void set_max_load_factor(float lf);
     void reserve(size_t n);
+    void set_incremental_rehash(bool enabled);
+    HashDiagnostics diagnostics() const;
     size_t get_comparisons() const;
+    StatsReport stats() const;
 };
 
-template <typename Key, typename Value, typename Hash>
-ChainedHashTable<Key, Value, Hash>::ChainedHashTable(size_t tableSize, float load_factor) {
-    m_table_size = get_next_prime(tableSize);
-    m_table.resize(m_table_size);
+template <typename Key, typename Value, typename Hash, typename Stats>
+ChainedHashTable<Key, Value, Hash, Stats>::ChainedHashTable(size_t tableSize, float load_factor) {
+    m_table_size = next_prime_size(tableSize);
+    m_mod = FastMod(static_cast<uint32_t>(m_table_size));
+    m_table.assign(m_table_size, nullptr);
     m_number_of_elements = 0;
     m_max_load_factor = (load_factor <= 0) ? 1.0 : load_factor;
 }
 
-template <typename Key, typename Value, typename Hash>
-size_t ChainedHashTable<Key, Value, Hash>::get_next_prime(size_t x) {
-    if (x <= 2) return 3;
-    x = (x % 2 == 0) ? x + 1 : x;
-    while (true) {
-        bool not_prime = false;
-        for (int i = 3; i <= sqrt(x); i += 2) {
-            if (x % i == 0) {
-                not_prime = true;
-                break;
-            }
-        }
-        if (!not_prime) break;
-        x += 2;
-    }
-    return x;
+template <typename Key, typename Value, typename Hash, typename Stats>
+ChainedHashTable<Key, Value, Hash, Stats>::~ChainedHashTable() {
+    clear();
+}
+
+template <typename Key, typename Value, typename Hash, typename Stats>
+size_t ChainedHashTable<Key, Value, Hash, Stats>::hash_code(const Key& k) const {
+    return m_mod(m_hashing(k));
 }
 
-template <typename Key, typename Value, typename Hash>
-size_t ChainedHashTable<Key, Value, Hash>::hash_code(const Key& k) const {
-    return m_hashing(k) % m_table_size;
+// Procura a chave na tabela nova e, durante um rehash incremental, no balde
+// ainda não migrado da tabela antiga
+template <typename Key, typename Value, typename Hash, typename Stats>
+typename ChainedHashTable<Key, Value, Hash, Stats>::HashNode* ChainedHashTable<Key, Value, Hash, Stats>::find(const Key& k) const {
+    return find_hashed(m_hashing(k), k);
 }
 
-template <typename Key, typename Value, typename Hash>
-bool ChainedHashTable<Key, Value, Hash>::add(const Key& k, const Value& v) {
-    if (load_factor() >= m_max_load_factor) {
-        rehash(2 * m_table_size);
+template <typename Key, typename Value, typename Hash, typename Stats>
+typename ChainedHashTable<Key, Value, Hash, Stats>::HashNode* ChainedHashTable<Key, Value, Hash, Stats>::find_hashed(size_t h, const Key& k) const {
+    HashNode* node = find_in(m_table[m_mod(h)], h, k);
+    if (node == nullptr && rehashing()) {
+        size_t old_slot = m_old_mod(h);
+        if (old_slot >= m_migrated) node = find_in(m_old_table[old_slot], h, k);
     }
-    size_t slot = hash_code(k);
-    for (const auto& p : m_table[slot]) {
-        key_comparisons++;
-        if (p.first == k) return false;
+    return node;
+}
+
+template <typename Key, typename Value, typename Hash, typename Stats>
+typename ChainedHashTable<Key, Value, Hash, Stats>::HashNode* ChainedHashTable<Key, Value, Hash, Stats>::find_in(Bucket b, size_t h, const Key& k) const {
+    for (HashNode* node = b; node != nullptr; node = node->next) {
+        m_stats.probe();
+        if (node->hash != h) continue;
+        m_stats.comparison();
+        if (node->key == k) return node;
+    }
+    return nullptr;
+}
+
+// Insere uma chave sabidamente ausente, crescendo a tabela se preciso
+template <typename Key, typename Value, typename Hash, typename Stats>
+void ChainedHashTable<Key, Value, Hash, Stats>::push_new(size_t h, const Key& k, const Value& v) {
+    if (!rehashing() && load_factor() >= m_max_load_factor) {
+        if (m_incremental) start_rehash(2 * m_table_size);
+        else rehash(2 * m_table_size);
     }
-    m_table[slot].emplace_back(k, v);
+    Bucket& b = m_table[m_mod(h)];
+    b = m_pool.acquire(b, h, k, v);
     m_number_of_elements++;
+}
+
+template <typename Key, typename Value, typename Hash, typename Stats>
+bool ChainedHashTable<Key, Value, Hash, Stats>::add(const Key& k, const Value& v) {
+    if (rehashing()) migrate_step(REHASH_STEP);
+    if (find(k) != nullptr) return false;
+    push_new(m_hashing(k), k, v);
     return true;
 }
 
-template <typename Key, typename Value, typename Hash>
-void ChainedHashTable<Key, Value, Hash>::update(const Key& k, const Value& new_value) {
-    size_t slot = hash_code(k);
-    for (auto& p : m_table[slot]) {
-        key_comparisons++;
-        if (p.first == k) {
-            p.second = new_value;
-            return;
-        }
-    }
-    throw std::runtime_error("Chave não encontrada para atualização");
+// Como add, mas devolve o valor que ficou na chave; o hash é calculado uma vez
+template <typename Key, typename Value, typename Hash, typename Stats>
+Value ChainedHashTable<Key, Value, Hash, Stats>::insert_or_get(const Key& k, const Value& v) {
+    if (rehashing()) migrate_step(REHASH_STEP);
+    size_t h = m_hashing(k);
+    HashNode* node = find_hashed(h, k);
+    if (node != nullptr) return node->value;
+    push_new(h, k, v);
+    return v;
 }
 
-template <typename Key, typename Value, typename Hash>
-Value ChainedHashTable<Key, Value, Hash>::get(const Key& k) const {
-    size_t slot = hash_code(k);
-    for (const auto& p : m_table[slot]) {
-        key_comparisons++;
-        if (p.first == k) return p.second;
+// Insere a chave com contagem 1 ou incrementa a contagem existente,
+// no mesmo formato do insert das árvores
+template <typename Key, typename Value, typename Hash, typename Stats>
+void ChainedHashTable<Key, Value, Hash, Stats>::insert(const Key& k) {
+    if (rehashing()) migrate_step(REHASH_STEP);
+    HashNode* node = find(k);
+    if (node != nullptr) {
+        node->value++;
+        return;
     }
-    throw std::runtime_error("Chave não encontrada");
+    push_new(m_hashing(k), k, 1);
 }
 
-template <typename Key, typename Value, typename Hash>
-bool ChainedHashTable<Key, Value, Hash>::remove(const Key& k) {
-    size_t slot = hash_code(k);
-    for (auto it = m_table[slot].begin(); it != m_table[slot].end(); ++it) {
-        key_comparisons++;
-        if (it->first == k) {
-            m_table[slot].erase(it);
-            m_number_of_elements--;
-            return true;
+template <typename Key, typename Value, typename Hash, typename Stats>
+void ChainedHashTable<Key, Value, Hash, Stats>::update(const Key& k, const Value& new_value) {
+    if (rehashing()) migrate_step(REHASH_STEP);
+    HashNode* node = find(k);
+    if (node == nullptr) throw std::runtime_error("Chave não encontrada para atualização");
+    node->value = new_value;
+}
+
+template <typename Key, typename Value, typename Hash, typename Stats>
+Value ChainedHashTable<Key, Value, Hash, Stats>::get(const Key& k) const {
+    const HashNode* node = find(k);
+    if (node == nullptr) throw std::runtime_error("Chave não encontrada");
+    return node->value;
+}
+
+// Tira uma ocorrência da chave; ao chegar a zero, o nó volta ao pool.
+// Devolve true quando a chave saiu da tabela.
+template <typename Key, typename Value, typename Hash, typename Stats>
+bool ChainedHashTable<Key, Value, Hash, Stats>::decrement(const Key& k) {
+    if (rehashing()) migrate_step(REHASH_STEP);
+    size_t h = m_hashing(k);
+    Bucket* b = &m_table[m_mod(h)];
+    for (int pass = 0; pass < 2; ++pass) {
+        for (HashNode** link = b; *link != nullptr; link = &(*link)->next) {
+            HashNode* node = *link;
+            m_stats.probe();
+            if (node->hash != h) continue;
+            m_stats.comparison();
+            if (node->key == k) {
+                if (node->value > 1) {
+                    node->value--;
+                    return false;
+                }
+                *link = node->next;
+                m_pool.release(node);
+                m_number_of_elements--;
+                return true;
+            }
         }
+        if (!rehashing() || m_old_mod(h) < m_migrated) break;
+        b = &m_old_table[m_old_mod(h)];
     }
     return false;
 }
 
-template <typename Key, typename Value, typename Hash>
-bool ChainedHashTable<Key, Value, Hash>::contains(const Key& k) const {
-    size_t slot = hash_code(k);
-    for (const auto& p : m_table[slot]) {
-        if (p.first == k) return true;
+template <typename Key, typename Value, typename Hash, typename Stats>
+bool ChainedHashTable<Key, Value, Hash, Stats>::remove(const Key& k) {
+    if (rehashing()) migrate_step(REHASH_STEP);
+    size_t h = m_hashing(k);
+    Bucket* b = &m_table[m_mod(h)];
+    for (int pass = 0; pass < 2; ++pass) {
+        for (HashNode** link = b; *link != nullptr; link = &(*link)->next) {
+            HashNode* node = *link;
+            m_stats.probe();
+            if (node->hash != h) continue;
+            m_stats.comparison();
+            if (node->key == k) {
+                *link = node->next;
+                m_pool.release(node);
+                m_number_of_elements--;
+                return true;
+            }
+        }
+        if (!rehashing() || m_old_mod(h) < m_migrated) break;
+        b = &m_old_table[m_old_mod(h)];
     }
     return false;
 }
 
-template <typename Key, typename Value, typename Hash>
-void ChainedHashTable<Key, Value, Hash>::forEach(std::function<void(const Key&, const Value&)> func) const {
-    for (const auto& bucket : m_table) {
-        for (const auto& p : bucket) {
-            func(p.first, p.second);
+template <typename Key, typename Value, typename Hash, typename Stats>
+bool ChainedHashTable<Key, Value, Hash, Stats>::contains(const Key& k) const {
+    return find(k) != nullptr;
+}
+
+template <typename Key, typename Value, typename Hash, typename Stats>
+size_t ChainedHashTable<Key, Value, Hash, Stats>::get_batch(const Key* keys, size_t n, Value* out, const Value& missing) const {
+    return lookup_batch(keys, n, [&](size_t i, const HashNode* node) {
+        out[i] = node ? node->value : missing;
+    });
+}
+
+template <typename Key, typename Value, typename Hash, typename Stats>
+size_t ChainedHashTable<Key, Value, Hash, Stats>::contains_batch(const Key* keys, size_t n, bool* out) const {
+    return lookup_batch(keys, n, [&](size_t i, const HashNode* node) {
+        out[i] = node != nullptr;
+    });
+}
+
+// Buscas em lote: para cada grupo, calcula todos os hashes e pede os baldes
+// com prefetch, depois pede o primeiro nó de cada cadeia e só então compara.
+// As faltas de cache das buscas independentes se sobrepõem.
+template <typename Key, typename Value, typename Hash, typename Stats>
+template <typename Emit>
+size_t ChainedHashTable<Key, Value, Hash, Stats>::lookup_batch(const Key* keys, size_t n, Emit&& emit) const {
+    size_t hashes[BATCH_GROUP];
+    const Bucket* slots[BATCH_GROUP];
+    size_t found = 0;
+    for (size_t base = 0; base < n; base += BATCH_GROUP) {
+        size_t g = std::min(BATCH_GROUP, n - base);
+        for (size_t j = 0; j < g; j++) {
+            hashes[j] = m_hashing(keys[base + j]);
+            slots[j] = &m_table[m_mod(hashes[j])];
+            __builtin_prefetch(slots[j]);
+        }
+        for (size_t j = 0; j < g; j++) {
+            if (*slots[j] != nullptr) __builtin_prefetch(*slots[j]);
+        }
+        for (size_t j = 0; j < g; j++) {
+            const HashNode* node = find_hashed(hashes[j], keys[base + j]);
+            if (node != nullptr) found++;
+            emit(base + j, node);
         }
     }
+    return found;
 }
 
-template <typename Key, typename Value, typename Hash>
-void ChainedHashTable<Key, Value, Hash>::clear() {
-    for (auto& bucket : m_table) {
-        bucket.clear();
+template <typename Key, typename Value, typename Hash, typename Stats>
+void ChainedHashTable<Key, Value, Hash, Stats>::forEach(std::function<void(const Key&, const Value&)> func) const {
+    for (const HashNode* bucket : m_table) {
+        for (const HashNode* node = bucket; node != nullptr; node = node->next) {
+            func(node->key, node->value);
+        }
+    }
+    for (size_t i = m_migrated; i < m_old_table.size(); ++i) {
+        for (const HashNode* node = m_old_table[i]; node != nullptr; node = node->next) {
+            func(node->key, node->value);
+        }
     }
+}
+
+template <typename Key, typename Value, typename Hash, typename Stats>
+void ChainedHashTable<Key, Value, Hash, Stats>::clear() {
+    release_all(m_table);
+    release_all(m_old_table);
+    m_old_table.clear();
+    m_old_size = m_migrated = 0;
     m_number_of_elements = 0;
 }
 
-template <typename Key, typename Value, typename Hash>
-size_t ChainedHashTable<Key, Value, Hash>::size() const {
+template <typename Key, typename Value, typename Hash, typename Stats>
+size_t ChainedHashTable<Key, Value, Hash, Stats>::size() const {
     return m_number_of_elements;
 }
 
-template <typename Key, typename Value, typename Hash>
-size_t ChainedHashTable<Key, Value, Hash>::bucket_count() const {
+template <typename Key, typename Value, typename Hash, typename Stats>
+size_t ChainedHashTable<Key, Value, Hash, Stats>::bucket_count() const {
     return m_table_size;
 }
 
-template <typename Key, typename Value, typename Hash>
-size_t ChainedHashTable<Key, Value, Hash>::bucket_size(size_t n) const {
+template <typename Key, typename Value, typename Hash, typename Stats>
+size_t ChainedHashTable<Key, Value, Hash, Stats>::bucket_size(size_t n) const {
     if (n >= m_table_size) throw std::out_of_range("invalid index");
-    return m_table[n].size();
+    size_t count = 0;
+    for (const HashNode* node = m_table[n]; node != nullptr; node = node->next) count++;
+    return count;
 }
 
-template <typename Key, typename Value, typename Hash>
-size_t ChainedHashTable<Key, Value, Hash>::bucket(const Key& k) const {
+template <typename Key, typename Value, typename Hash, typename Stats>
+size_t ChainedHashTable<Key, Value, Hash, Stats>::bucket(const Key& k) const {
     return hash_code(k);
 }
 
-template <typename Key, typename Value, typename Hash>
-float ChainedHashTable<Key, Value, Hash>::load_factor() const {
+template <typename Key, typename Value, typename Hash, typename Stats>
+float ChainedHashTable<Key, Value, Hash, Stats>::load_factor() const {
     return static_cast<float>(m_number_of_elements) / m_table_size;
 }
 
-template <typename Key, typename Value, typename Hash>
-float ChainedHashTable<Key, Value, Hash>::max_load_factor() const {
+template <typename Key, typename Value, typename Hash, typename Stats>
+float ChainedHashTable<Key, Value, Hash, Stats>::max_load_factor() const {
     return m_max_load_factor;
 }
 
-template <typename Key, typename Value, typename Hash>
-void ChainedHashTable<Key, Value, Hash>::set_max_load_factor(float lf) {
+template <typename Key, typename Value, typename Hash, typename Stats>
+void ChainedHashTable<Key, Value, Hash, Stats>::set_max_load_factor(float lf) {
     if (lf <= 0) throw std::out_of_range("invalid load factor");
     m_max_load_factor = lf;
     reserve(m_number_of_elements);
 }
 
-template <typename Key, typename Value, typename Hash>
-void ChainedHashTable<Key, Value, Hash>::reserve(size_t n) {
+template <typename Key, typename Value, typename Hash, typename Stats>
+void ChainedHashTable<Key, Value, Hash, Stats>::reserve(size_t n) {
     if (n > m_table_size * m_max_load_factor) {
         rehash(n / m_max_load_factor);
     }
 }
 
-template <typename Key, typename Value, typename Hash>
-void ChainedHashTable<Key, Value, Hash>::rehash(size_t m) {
-    size_t new_table_size = get_next_prime(m);
+// Com o modo incremental ligado, o crescimento deixa de parar tudo: cada
+// operação de escrita migra REHASH_STEP baldes da tabela antiga
+template <typename Key, typename Value, typename Hash, typename Stats>
+void ChainedHashTable<Key, Value, Hash, Stats>::set_incremental_rehash(bool enabled) {
+    if (!enabled) finish_rehash();
+    m_incremental = enabled;
+}
+
+// Rehash completo: os nós são religados nos novos baldes usando o hash
+// guardado, sem copiar chave/valor nem alocar
+template <typename Key, typename Value, typename Hash, typename Stats>
+void ChainedHashTable<Key, Value, Hash, Stats>::rehash(size_t m) {
+    finish_rehash();
+    size_t new_table_size = next_prime_size(m);
     if (new_table_size > m_table_size) {
-        std::vector<std::list<std::pair<Key, Value>>> old_table = std::move(m_table);
-        m_table.resize(new_table_size);
-        for (auto& bucket : m_table) bucket.clear();
-        m_table_size = new_table_size;
-        m_number_of_elements = 0;
-        for (const auto& bucket : old_table) {
-            for (const auto& p : bucket) {
-                add(p.first, p.second);
-            }
+        start_rehash(m);
+        finish_rehash();
+    }
+}
+
+template <typename Key, typename Value, typename Hash, typename Stats>
+void ChainedHashTable<Key, Value, Hash, Stats>::start_rehash(size_t m) {
+    size_t new_table_size = next_prime_size(m);
+    if (new_table_size <= m_table_size) return;
+    m_old_table = std::move(m_table);
+    m_old_size = m_table_size;
+    m_old_mod = m_mod;
+    m_migrated = 0;
+    m_table = std::vector<Bucket>(new_table_size, nullptr);
+    m_table_size = new_table_size;
+    m_mod = FastMod(static_cast<uint32_t>(m_table_size));
+}
+
+template <typename Key, typename Value, typename Hash, typename Stats>
+void ChainedHashTable<Key, Value, Hash, Stats>::migrate_step(size_t buckets) {
+    size_t end = std::min(m_old_size, m_migrated + buckets);
+    for (; m_migrated < end; ++m_migrated) {
+        HashNode* node = m_old_table[m_migrated];
+        while (node != nullptr) {
+            HashNode* next = node->next;
+            Bucket& target = m_table[m_mod(node->hash)];
+            node->next = target;
+            target = node;
+            node = next;
+        }
+        m_old_table[m_migrated] = nullptr;
+    }
+    if (m_migrated == m_old_size) {
+        m_old_table = std::vector<Bucket>();
+        m_old_size = m_migrated = 0;
+    }
+}
+
+template <typename Key, typename Value, typename Hash, typename Stats>
+void ChainedHashTable<Key, Value, Hash, Stats>::finish_rehash() {
+    if (rehashing()) migrate_step(m_old_size);
+}
+
+template <typename Key, typename Value, typename Hash, typename Stats>
+void ChainedHashTable<Key, Value, Hash, Stats>::release_all(std::vector<Bucket>& table) {
+    for (Bucket& bucket : table) {
+        HashNode* node = bucket;
+        while (node != nullptr) {
+            HashNode* next = node->next;
+            m_pool.release(node);
+            node = next;
+        }
+        bucket = nullptr;
+    }
+}
+
+template <typename Key, typename Value, typename Hash, typename Stats>
+HashDiagnostics ChainedHashTable<Key, Value, Hash, Stats>::diagnostics() const {
+    HashDiagnostics d;
+    d.buckets = bucket_count();
+    d.elements = size();
+    d.load_factor = load_factor();
+    size_t probes = 0;
+    std::vector<size_t> chain(d.buckets);
+    for (size_t i = 0; i < d.buckets; i++) {
+        chain[i] = bucket_size(i);
+        probes += chain[i] * (chain[i] + 1) / 2;  // a k-ésima chave do balde custa k sondagens
+    }
+    // Durante um rehash incremental, os nós ainda na tabela antiga contam no
+    // balde de destino; a busca por eles percorre a cadeia nova inteira e
+    // depois a antiga até chegar neles
+    for (size_t i = m_migrated; i < m_old_table.size(); ++i) {
+        size_t k = 0;
+        for (const HashNode* node = m_old_table[i]; node != nullptr; node = node->next) {
+            probes += bucket_size(m_mod(node->hash)) + ++k;
+            chain[m_mod(node->hash)]++;
         }
     }
+    for (size_t len : chain) {
+        if (len >= d.histogram.size()) d.histogram.resize(len + 1, 0);
+        d.histogram[len]++;
+        d.max_chain = std::max(d.max_chain, len);
+    }
+    d.expected_probes = 1 + d.load_factor / 2;
+    d.actual_probes = d.elements ? double(probes) / d.elements : 0;
+    d.expected_empty = std::exp(-d.load_factor);
+    d.actual_empty = d.histogram.empty() ? 0 : double(d.histogram[0]) / d.buckets;
+    return d;
+}
+
+template <typename Key, typename Value, typename Hash, typename Stats>
+bool ChainedHashTable<Key, Value, Hash, Stats>::rehashing() const {
+    return m_old_size != 0;
+}
+
+template <typename Key, typename Value, typename Hash, typename Stats>
+size_t ChainedHashTable<Key, Value, Hash, Stats>::get_comparisons() const {
+    return m_stats.report().comparisons;
 }
 
-template <typename Key, typename Value, typename Hash>
-size_t ChainedHashTable<Key, Value, Hash>::get_comparisons() const {
-    return key_comparisons;
+// Contadores da política Stats (todos zero com NoStats)
+template <typename Key, typename Value, typename Hash, typename Stats>
+StatsReport ChainedHashTable<Key, Value, Hash, Stats>::stats() const {
+    return m_stats.report();
 }
 
-#endif // CHAINED_HASHTABLE_HPP
\ No newline at end of file
+#endif // CHAINED_HASHTABLE_HPP
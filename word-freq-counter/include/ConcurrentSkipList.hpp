@@ -0,0 +1,351 @@
+#ifndef CONCURRENT_SKIP_LIST_HPP
+#define CONCURRENT_SKIP_LIST_HPP
+
+#include <iostream>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "EpochReclamation.hpp"
+
+// Dicionário ordenado sem trava para várias threads escrevendo ao mesmo
+// tempo (lista de saltos de Herlihy/Shavit). Os ponteiros "next" carregam
+// no bit mais baixo a marca de remoção lógica; inserir é um CAS no nível 0
+// seguido da ligação dos níveis superiores. A contagem de cada chave é um
+// contador atômico, e -1 nele indica que o nó já foi removido, de modo que
+// um incremento nunca se perde num nó morto.
+// A memória dos nós removidos é devolvida por épocas (EpochManager).
+template <typename Key, typename Value>
+class ConcurrentSkipList {
+    static_assert(std::is_integral<Value>::value && std::is_signed<Value>::value,
+                  "ConcurrentSkipList conta com um Value inteiro com sinal");
+public:
+    ConcurrentSkipList();
+    ~ConcurrentSkipList();
+
+    ConcurrentSkipList(const ConcurrentSkipList&) = delete;
+    ConcurrentSkipList& operator=(const ConcurrentSkipList&) = delete;
+
+    // Todas as operações podem ser chamadas de qualquer thread
+    void add(const Key& k, const Value& v);
+    void insert(const Key& k);          // insere com 1 ou incrementa
+    Value insert_or_get(const Key& k, const Value& v);  // valor atual, ou v recém-inserido
+    void update(const Key& k, const Value& v);
+    Value get(const Key& k) const;
+    bool remove(const Key& k);
+    bool contains(const Key& k) const;
+
+    // Percorre em ordem alfabética. Seguro durante escritas concorrentes:
+    // cada chave presente do início ao fim da travessia aparece uma vez, e
+    // chaves inseridas ou removidas no meio podem ou não aparecer.
+    template <typename F>
+    void forEach(F&& func) const;
+    void print(std::ostream& out) const;
+
+    int size() const;
+    void clear();                       // não concorrente
+
+private:
+    static constexpr int MAX_LEVEL = 24;
+    static constexpr Value DEAD = -1;
+
+    // O que upsert faz com o valor de uma chave já presente
+    enum Upsert { OVERWRITE, ACCUMULATE, KEEP };
+
+    struct SkipNode {
+        Key key;
+        std::atomic<Value> value;
+        SkipNode* retired_next;         // usado pelo EpochManager
+        std::atomic<int> owners;        // inseridor e removedor; o último retira
+        int height;
+        std::atomic<uintptr_t> next[1]; // na verdade 'height' posições
+
+        SkipNode(const Key& k, Value v, int h) : key(k), value(v), retired_next(nullptr), owners(2), height(h) {}
+    };
+
+    using Epochs = EpochManager<SkipNode>;
+
+    SkipNode* m_head;
+    std::atomic<int> m_size;
+    mutable Epochs m_epochs;
+
+    static SkipNode* make_node(const Key& k, Value v, int height);
+    static void destroy_node(SkipNode* node);
+    static int random_height();
+
+    static bool marked(uintptr_t p) { return p & 1; }
+    static SkipNode* ptr(uintptr_t p) { return reinterpret_cast<SkipNode*>(p & ~uintptr_t(1)); }
+    static uintptr_t raw(SkipNode* p) { return reinterpret_cast<uintptr_t>(p); }
+
+    bool find(const Key& k, SkipNode** preds, SkipNode** succs) const;
+    SkipNode* find_live(const Key& k) const;
+    Value upsert(const Key& k, Value v, Upsert mode);
+    void link_upper(SkipNode* node, SkipNode** preds, SkipNode** succs);
+    void release(SkipNode* node);
+};
+
+template <typename Key, typename Value>
+ConcurrentSkipList<Key, Value>::ConcurrentSkipList() : m_epochs(&ConcurrentSkipList::destroy_node) {
+    m_head = make_node(Key(), 0, MAX_LEVEL);
+    m_size.store(0);
+}
+
+template <typename Key, typename Value>
+ConcurrentSkipList<Key, Value>::~ConcurrentSkipList() {
+    clear();
+    destroy_node(m_head);
+}
+
+template <typename Key, typename Value>
+typename ConcurrentSkipList<Key, Value>::SkipNode*
+ConcurrentSkipList<Key, Value>::make_node(const Key& k, Value v, int height) {
+    size_t bytes = sizeof(SkipNode) + (height - 1) * sizeof(std::atomic<uintptr_t>);
+    void* mem = ::operator new(bytes);
+    SkipNode* node = new (mem) SkipNode(k, v, height);
+    for (int i = 1; i < height; i++) new (&node->next[i]) std::atomic<uintptr_t>(0);
+    node->next[0].store(0, std::memory_order_relaxed);
+    return node;
+}
+
+template <typename Key, typename Value>
+void ConcurrentSkipList<Key, Value>::destroy_node(SkipNode* node) {
+    node->~SkipNode();
+    ::operator delete(node);
+}
+
+// Altura geométrica com p = 1/2, sorteada por um gerador próprio de cada thread
+template <typename Key, typename Value>
+int ConcurrentSkipList<Key, Value>::random_height() {
+    static thread_local std::minstd_rand rng(std::random_device{}());
+    int h = 1;
+    uint32_t bits = static_cast<uint32_t>(rng());
+    while (h < MAX_LEVEL && (bits & 1)) {
+        h++;
+        bits >>= 1;
+    }
+    return h;
+}
+
+// Preenche os predecessores/sucessores de k em cada nível, desligando no
+// caminho os nós marcados. Devolve true se succs[0] tem a chave k.
+template <typename Key, typename Value>
+bool ConcurrentSkipList<Key, Value>::find(const Key& k, SkipNode** preds, SkipNode** succs) const {
+retry:
+    SkipNode* pred = m_head;
+    for (int level = MAX_LEVEL - 1; level >= 0; level--) {
+        SkipNode* curr = ptr(pred->next[level].load());
+        while (curr) {
+            uintptr_t succ = curr->next[level].load();
+            while (marked(succ)) {
+                uintptr_t expected = raw(curr);
+                if (!pred->next[level].compare_exchange_strong(expected, raw(ptr(succ)))) goto retry;
+                curr = ptr(succ);
+                if (!curr) break;
+                succ = curr->next[level].load();
+            }
+            if (curr && curr->key < k) {
+                pred = curr;
+                curr = ptr(succ);
+            } else {
+                break;
+            }
+        }
+        preds[level] = pred;
+        succs[level] = curr;
+    }
+    return succs[0] && !(k < succs[0]->key);
+}
+
+// Busca só de leitura: pula os nós marcados sem desligá-los
+template <typename Key, typename Value>
+typename ConcurrentSkipList<Key, Value>::SkipNode*
+ConcurrentSkipList<Key, Value>::find_live(const Key& k) const {
+    SkipNode* pred = m_head;
+    SkipNode* curr = nullptr;
+    for (int level = MAX_LEVEL - 1; level >= 0; level--) {
+        curr = ptr(pred->next[level].load());
+        while (curr) {
+            uintptr_t succ = curr->next[level].load();
+            if (marked(succ)) {
+                curr = ptr(succ);
+            } else if (curr->key < k) {
+                pred = curr;
+                curr = ptr(succ);
+            } else {
+                break;
+            }
+        }
+    }
+    if (curr && !(k < curr->key) && curr->value.load() != DEAD) return curr;
+    return nullptr;
+}
+
+// Devolve o valor que fica na chave
+template <typename Key, typename Value>
+Value ConcurrentSkipList<Key, Value>::upsert(const Key& k, Value v, Upsert mode) {
+    typename Epochs::Guard guard(m_epochs);
+    SkipNode* preds[MAX_LEVEL];
+    SkipNode* succs[MAX_LEVEL];
+    SkipNode* node = nullptr;
+    while (true) {
+        if (find(k, preds, succs)) {
+            // Chave presente: incrementa/sobrescreve/mantém, a menos que esteja morrendo
+            SkipNode* found = succs[0];
+            Value cur = found->value.load();
+            Value next = cur;
+            while (cur != DEAD && mode != KEEP) {
+                next = mode == ACCUMULATE ? cur + v : v;
+                if (found->value.compare_exchange_weak(cur, next)) break;
+            }
+            if (cur != DEAD) {
+                if (node) destroy_node(node);   // nunca publicado
+                return mode == KEEP ? cur : next;
+            }
+            continue;   // o removedor ainda vai desligá-lo; tenta de novo
+        }
+        if (!node) node = make_node(k, v, random_height());
+        for (int i = 0; i < node->height; i++) {
+            node->next[i].store(raw(succs[i]), std::memory_order_relaxed);
+        }
+        uintptr_t expected = raw(succs[0]);
+        if (preds[0]->next[0].compare_exchange_strong(expected, raw(node))) break;
+    }
+    m_size.fetch_add(1);
+    link_upper(node, preds, succs);
+    release(node);
+    return v;
+}
+
+// Liga os níveis 1..height-1. Se o nó for removido no meio, para, e garante
+// com um novo find que ele não fique ligado em nenhum nível.
+template <typename Key, typename Value>
+void ConcurrentSkipList<Key, Value>::link_upper(SkipNode* node, SkipNode** preds, SkipNode** succs) {
+    for (int level = 1; level < node->height; level++) {
+        while (true) {
+            uintptr_t mine = node->next[level].load();
+            if (marked(mine)) goto done;
+            if (ptr(mine) != succs[level] &&
+                !node->next[level].compare_exchange_strong(mine, raw(succs[level]))) {
+                continue;
+            }
+            uintptr_t expected = raw(succs[level]);
+            if (preds[level]->next[level].compare_exchange_strong(expected, raw(node))) break;
+            find(node->key, preds, succs);
+            if (succs[0] != node) goto done;
+        }
+    }
+done:
+    if (marked(node->next[0].load())) find(node->key, preds, succs);
+}
+
+// Cada nó tem dois donos, quem o insere e quem o remove; o segundo a
+// terminar entrega o nó às épocas, quando ele já não está ligado em nenhum nível
+template <typename Key, typename Value>
+void ConcurrentSkipList<Key, Value>::release(SkipNode* node) {
+    if (node->owners.fetch_sub(1) == 1) m_epochs.retire(node);
+}
+
+template <typename Key, typename Value>
+void ConcurrentSkipList<Key, Value>::add(const Key& k, const Value& v) {
+    upsert(k, v, OVERWRITE);
+}
+
+template <typename Key, typename Value>
+void ConcurrentSkipList<Key, Value>::insert(const Key& k) {
+    upsert(k, 1, ACCUMULATE);
+}
+
+template <typename Key, typename Value>
+Value ConcurrentSkipList<Key, Value>::insert_or_get(const Key& k, const Value& v) {
+    return upsert(k, v, KEEP);
+}
+
+template <typename Key, typename Value>
+void ConcurrentSkipList<Key, Value>::update(const Key& k, const Value& v) {
+    typename Epochs::Guard guard(m_epochs);
+    SkipNode* node = find_live(k);
+    if (!node) throw std::runtime_error("Chave não encontrada");
+    Value cur = node->value.load();
+    while (cur != DEAD && !node->value.compare_exchange_weak(cur, v)) {}
+    if (cur == DEAD) throw std::runtime_error("Chave não encontrada");
+}
+
+template <typename Key, typename Value>
+Value ConcurrentSkipList<Key, Value>::get(const Key& k) const {
+    typename Epochs::Guard guard(m_epochs);
+    SkipNode* node = find_live(k);
+    Value v = node ? node->value.load() : DEAD;
+    if (v == DEAD) throw std::runtime_error("Chave não encontrada");
+    return v;
+}
+
+template <typename Key, typename Value>
+bool ConcurrentSkipList<Key, Value>::contains(const Key& k) const {
+    typename Epochs::Guard guard(m_epochs);
+    return find_live(k) != nullptr;
+}
+
+// A troca do contador por DEAD é o ponto de linearização e elege um único
+// removedor; depois marca os níveis de cima para baixo e desliga o nó
+template <typename Key, typename Value>
+bool ConcurrentSkipList<Key, Value>::remove(const Key& k) {
+    typename Epochs::Guard guard(m_epochs);
+    SkipNode* preds[MAX_LEVEL];
+    SkipNode* succs[MAX_LEVEL];
+    if (!find(k, preds, succs)) return false;
+    SkipNode* node = succs[0];
+    Value cur = node->value.load();
+    do {
+        if (cur == DEAD) return false;
+    } while (!node->value.compare_exchange_weak(cur, DEAD));
+
+    for (int level = node->height - 1; level >= 0; level--) {
+        node->next[level].fetch_or(1);
+    }
+    m_size.fetch_sub(1);
+    find(k, preds, succs);
+    release(node);
+    return true;
+}
+
+template <typename Key, typename Value>
+template <typename F>
+void ConcurrentSkipList<Key, Value>::forEach(F&& func) const {
+    typename Epochs::Guard guard(m_epochs);
+    for (SkipNode* node = ptr(m_head->next[0].load()); node; node = ptr(node->next[0].load())) {
+        Value v = node->value.load();
+        if (v != DEAD && !marked(node->next[0].load())) func(node->key, v);
+    }
+}
+
+template <typename Key, typename Value>
+void ConcurrentSkipList<Key, Value>::print(std::ostream& out) const {
+    forEach([&](const Key& k, const Value& v) {
+        out << k << " : " << v << '\n';
+    });
+}
+
+template <typename Key, typename Value>
+int ConcurrentSkipList<Key, Value>::size() const {
+    return m_size.load();
+}
+
+template <typename Key, typename Value>
+void ConcurrentSkipList<Key, Value>::clear() {
+    SkipNode* node = ptr(m_head->next[0].load());
+    while (node) {
+        SkipNode* next = ptr(node->next[0].load());
+        // Nós marcados já foram (ou serão) entregues às épocas
+        if (node->value.load() != DEAD) destroy_node(node);
+        node = next;
+    }
+    for (int i = 0; i < MAX_LEVEL; i++) m_head->next[i].store(0);
+    m_size.store(0);
+}
+
+#endif // CONCURRENT_SKIP_LIST_HPP
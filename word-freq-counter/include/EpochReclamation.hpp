@@ -0,0 +1,139 @@
+#ifndef EPOCH_RECLAMATION_HPP
+#define EPOCH_RECLAMATION_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+// Reclamação de memória por épocas (EBR) para estruturas sem trava.
+// Cada operação fica "presa" à época global enquanto um Guard estiver vivo;
+// um nó retirado na época e só é liberado depois que a época global avança
+// duas vezes, quando nenhuma thread pode mais guardar um ponteiro para ele.
+// Os nós retirados formam uma pilha intrusiva por época (campo retired_next).
+template <typename Node>
+class EpochManager {
+public:
+    // Libera um nó já desligado da estrutura
+    using Deleter = void (*)(Node*);
+
+    explicit EpochManager(Deleter deleter);
+    ~EpochManager();
+
+    EpochManager(const EpochManager&) = delete;
+    EpochManager& operator=(const EpochManager&) = delete;
+
+    class Guard {
+    public:
+        explicit Guard(EpochManager& manager);
+        ~Guard();
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+    private:
+        EpochManager& m_manager;
+        size_t m_slot;
+    };
+
+    // Só pode ser chamado com um Guard ativo
+    void retire(Node* node);
+
+private:
+    static constexpr size_t SLOTS = 64;
+    static constexpr uint64_t INACTIVE = 0;
+
+    // Uma linha de cache por posição, para as threads não disputarem a mesma
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> pin{INACTIVE};   // época * 2 + 1 enquanto ativa
+    };
+
+    std::atomic<uint64_t> m_epoch;
+    Slot m_slots[SLOTS];
+    std::atomic<Node*> m_limbo[3];
+    std::atomic<size_t> m_retired_since_advance;
+    Deleter m_deleter;
+
+    size_t enter();
+    void leave(size_t slot);
+    void try_advance();
+    void free_list(Node* node);
+};
+
+template <typename Node>
+EpochManager<Node>::EpochManager(Deleter deleter) {
+    m_epoch.store(1);
+    for (auto& l : m_limbo) l.store(nullptr);
+    m_retired_since_advance.store(0);
+    m_deleter = deleter;
+}
+
+template <typename Node>
+EpochManager<Node>::~EpochManager() {
+    for (auto& l : m_limbo) free_list(l.exchange(nullptr));
+}
+
+template <typename Node>
+EpochManager<Node>::Guard::Guard(EpochManager& manager) : m_manager(manager) {
+    m_slot = manager.enter();
+}
+
+template <typename Node>
+EpochManager<Node>::Guard::~Guard() {
+    m_manager.leave(m_slot);
+}
+
+// Ocupa uma posição livre (começando por uma dica derivada da thread) e
+// anuncia a época corrente
+template <typename Node>
+size_t EpochManager<Node>::enter() {
+    static thread_local size_t hint = std::hash<std::thread::id>()(std::this_thread::get_id()) % SLOTS;
+    for (size_t i = hint;; i = (i + 1) % SLOTS) {
+        uint64_t expected = INACTIVE;
+        uint64_t pin = (m_epoch.load() << 1) | 1;
+        if (m_slots[i].pin.compare_exchange_strong(expected, pin)) {
+            hint = i;
+            return i;
+        }
+    }
+}
+
+template <typename Node>
+void EpochManager<Node>::leave(size_t slot) {
+    m_slots[slot].pin.store(INACTIVE, std::memory_order_release);
+}
+
+template <typename Node>
+void EpochManager<Node>::retire(Node* node) {
+    uint64_t e = m_epoch.load();
+    std::atomic<Node*>& head = m_limbo[e % 3];
+    node->retired_next = head.load(std::memory_order_relaxed);
+    while (!head.compare_exchange_weak(node->retired_next, node)) {}
+    if (m_retired_since_advance.fetch_add(1, std::memory_order_relaxed) >= SLOTS) try_advance();
+}
+
+// Avança de e para e + 1 se todas as threads ativas já estão em e; aí os
+// nós retirados em e - 1 ficam inalcançáveis e são liberados.
+// Quem chama está preso a uma época, então ninguém avança de novo até sair.
+template <typename Node>
+void EpochManager<Node>::try_advance() {
+    uint64_t e = m_epoch.load();
+    for (const Slot& s : m_slots) {
+        uint64_t pin = s.pin.load();
+        if (pin != INACTIVE && (pin >> 1) != e) return;
+    }
+    if (!m_epoch.compare_exchange_strong(e, e + 1)) return;
+    m_retired_since_advance.store(0, std::memory_order_relaxed);
+    free_list(m_limbo[(e + 2) % 3].exchange(nullptr));
+}
+
+template <typename Node>
+void EpochManager<Node>::free_list(Node* node) {
+    while (node) {
+        Node* next = node->retired_next;
+        m_deleter(node);
+        node = next;
+    }
+}
+
+#endif // EPOCH_RECLAMATION_HPP
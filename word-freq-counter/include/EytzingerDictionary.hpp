@@ -0,0 +1,265 @@
+#ifndef EYTZINGER_DICTIONARY_HPP
+#define EYTZINGER_DICTIONARY_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Dicionário ordenado imutável numa árvore de busca implícita no layout de
+// Eytzinger: a posição 1 é a raiz e os filhos de i são 2i e 2i+1, então a
+// descida é só aritmética de índices, sem ponteiros. Os primeiros 16 bytes
+// de cada chave (quase todas as palavras inteiras) ficam num vetor próprio
+// como dois inteiros big-endian, e é ele que a descida percorre: os 8
+// descendentes de i três níveis abaixo ocupam duas linhas de cache vizinhas,
+// buscadas antes de serem necessárias. A chave inteira (no bloco de chaves)
+// só é comparada quando os prefixos empatam. Os níveis de cima, os mais
+// visitados, ficam juntos no início.
+template <typename Key, typename Value>
+class EytzingerDictionary {
+    static_assert(std::is_same<Key, std::string>::value,
+                  "EytzingerDictionary guarda apenas chaves std::string");
+public:
+    EytzingerDictionary();
+
+    // Constrói a partir de qualquer dicionário com forEach(key, value)
+    template <typename Dict>
+    explicit EytzingerDictionary(const Dict& dict);
+
+    Value get(const Key& k) const;
+    bool contains(const Key& k) const;
+    // Quantidade de chaves menores que k
+    size_t rank(const Key& k) const;
+    // Chaves em [lo, hi], em ordem
+    template <typename F>
+    void range(const Key& lo, const Key& hi, F&& func) const;
+    // Todas as chaves, em ordem
+    template <typename F>
+    void forEach(F&& func) const;
+    int size() const;
+
+    size_t memory_usage() const;   // estrutura inteira, em bytes
+
+private:
+    // Bytes 0-7 e 8-15 da chave, completados com zero
+    struct Prefix {
+        uint64_t hi;
+        uint64_t lo;
+    };
+
+    struct Record {
+        uint32_t offset;            // início da chave em m_blob
+        uint32_t length;
+        uint32_t rank;              // posição na ordem das chaves
+        Value value;
+    };
+
+    size_t m_n;
+    std::vector<Prefix> m_prefix;       // [0] sem uso; [1..n] na ordem de Eytzinger
+    std::vector<Record> m_records;      // idem
+    std::string m_blob;                 // chaves concatenadas, na ordem de Eytzinger
+
+    static uint64_t load_be(const char* data, size_t length);
+    static Prefix prefix_of(const Key& k);
+    bool less(size_t i, const Key& k, const Prefix& p) const;
+    bool equals(size_t i, const Key& k) const;
+    size_t lower_bound(const Key& k) const;
+    size_t successor(size_t i) const;
+    size_t first() const;
+    size_t fill(const std::vector<std::pair<Key, Value>>& sorted, size_t i, size_t next);
+};
+
+template <typename Key, typename Value>
+EytzingerDictionary<Key, Value>::EytzingerDictionary() : m_n(0), m_prefix(1, Prefix{0, 0}), m_records(1) {}
+
+template <typename Key, typename Value>
+template <typename Dict>
+EytzingerDictionary<Key, Value>::EytzingerDictionary(const Dict& dict) : EytzingerDictionary() {
+    std::vector<std::pair<Key, Value>> entries;
+    entries.reserve(dict.size());
+    dict.forEach([&](const Key& k, const Value& v) {
+        entries.emplace_back(k, v);
+    });
+    if (entries.size() >= UINT32_MAX) throw std::length_error("chaves demais para o dicionário ordenado");
+    // As árvores já entregam em ordem; as tabelas hash não
+    if (!std::is_sorted(entries.begin(), entries.end(),
+                        [](const auto& a, const auto& b) { return a.first < b.first; })) {
+        std::sort(entries.begin(), entries.end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
+    }
+
+    m_n = entries.size();
+    m_prefix.assign(m_n + 1, Prefix{0, 0});
+    m_records.assign(m_n + 1, Record());
+    fill(entries, 1, 0);
+
+    // Bloco na ordem de Eytzinger, para os níveis de cima ficarem juntos
+    size_t bytes = 0;
+    for (const auto& e : entries) bytes += e.first.size();
+    if (bytes > UINT32_MAX) throw std::length_error("chaves longas demais para o dicionário ordenado");
+    m_blob.reserve(bytes);
+    for (size_t i = 1; i <= m_n; i++) {
+        const Key& k = entries[m_records[i].rank].first;
+        m_records[i].offset = static_cast<uint32_t>(m_blob.size());
+        m_records[i].length = static_cast<uint32_t>(k.size());
+        m_blob += k;
+    }
+}
+
+// Percurso em ordem da árvore implícita: a i-ésima posição visitada recebe
+// a i-ésima menor chave. Profundidade log2(n), então a recursão é segura.
+template <typename Key, typename Value>
+size_t EytzingerDictionary<Key, Value>::fill(const std::vector<std::pair<Key, Value>>& sorted, size_t i, size_t next) {
+    if (i > m_n) return next;
+    next = fill(sorted, 2 * i, next);
+    const auto& e = sorted[next];
+    m_prefix[i] = prefix_of(e.first);
+    m_records[i].rank = static_cast<uint32_t>(next);
+    m_records[i].value = e.second;
+    return fill(sorted, 2 * i + 1, next + 1);
+}
+
+// Até 8 bytes em big-endian, completados com zero: a ordem dos pares
+// (hi, lo) é a ordem das strings, exceto quando os prefixos empatam
+template <typename Key, typename Value>
+uint64_t EytzingerDictionary<Key, Value>::load_be(const char* data, size_t length) {
+    uint64_t p = 0;
+    size_t n = std::min<size_t>(length, 8);
+    for (size_t j = 0; j < n; j++) {
+        p |= uint64_t(static_cast<unsigned char>(data[j])) << (56 - 8 * j);
+    }
+    return p;
+}
+
+template <typename Key, typename Value>
+typename EytzingerDictionary<Key, Value>::Prefix EytzingerDictionary<Key, Value>::prefix_of(const Key& k) {
+    return Prefix{load_be(k.data(), k.size()), k.size() > 8 ? load_be(k.data() + 8, k.size() - 8) : 0};
+}
+
+template <typename Key, typename Value>
+bool EytzingerDictionary<Key, Value>::less(size_t i, const Key& k, const Prefix& p) const {
+    const Prefix& q = m_prefix[i];
+    bool lt = (q.hi < p.hi) | ((q.hi == p.hi) & (q.lo < p.lo));
+    // Um único teste para o empate, raro e portanto bem previsto
+    if (((q.hi ^ p.hi) | (q.lo ^ p.lo)) == 0) {
+        const Record& r = m_records[i];
+        lt = k.compare(0, k.size(), m_blob.data() + r.offset, r.length) > 0;
+    }
+    return lt;
+}
+
+template <typename Key, typename Value>
+bool EytzingerDictionary<Key, Value>::equals(size_t i, const Key& k) const {
+    const Record& r = m_records[i];
+    return r.length == k.size() && std::memcmp(m_blob.data() + r.offset, k.data(), r.length) == 0;
+}
+
+// Posição da menor chave >= k, ou 0. A descida não tem desvio dependente da
+// comparação: o resultado vira o bit baixo do próximo índice. No fim, os
+// passos à direita finais (bits 1) e o último à esquerda são desfeitos.
+template <typename Key, typename Value>
+size_t EytzingerDictionary<Key, Value>::lower_bound(const Key& k) const {
+    Prefix p = prefix_of(k);
+    const Prefix* prefix = m_prefix.data();
+    size_t i = 1;
+    while (i <= m_n) {
+#if defined(__GNUC__)
+        const Prefix* ahead = prefix + std::min(8 * i, m_n);
+        __builtin_prefetch(ahead);
+        __builtin_prefetch(ahead + 4);
+#endif
+        i = 2 * i + less(i, k, p);
+    }
+#if defined(__GNUC__)
+    i >>= __builtin_ffsll(~static_cast<long long>(i));
+#else
+    while (i & 1) i >>= 1;
+    i >>= 1;
+#endif
+    return i;
+}
+
+// Próxima posição em ordem: o mínimo da subárvore direita ou, sem ela, o
+// primeiro ancestral de quem i está à esquerda
+template <typename Key, typename Value>
+size_t EytzingerDictionary<Key, Value>::successor(size_t i) const {
+    if (2 * i + 1 <= m_n) {
+        i = 2 * i + 1;
+        while (2 * i <= m_n) i *= 2;
+        return i;
+    }
+    while (i & 1) i >>= 1;
+    return i >> 1;
+}
+
+template <typename Key, typename Value>
+size_t EytzingerDictionary<Key, Value>::first() const {
+    if (m_n == 0) return 0;
+    size_t i = 1;
+    while (2 * i <= m_n) i *= 2;
+    return i;
+}
+
+template <typename Key, typename Value>
+Value EytzingerDictionary<Key, Value>::get(const Key& k) const {
+    size_t i = lower_bound(k);
+    if (i == 0 || !equals(i, k)) throw std::runtime_error("Chave não encontrada");
+    return m_records[i].value;
+}
+
+template <typename Key, typename Value>
+bool EytzingerDictionary<Key, Value>::contains(const Key& k) const {
+    size_t i = lower_bound(k);
+    return i != 0 && equals(i, k);
+}
+
+template <typename Key, typename Value>
+size_t EytzingerDictionary<Key, Value>::rank(const Key& k) const {
+    size_t i = lower_bound(k);
+    return i == 0 ? m_n : m_records[i].rank;
+}
+
+template <typename Key, typename Value>
+template <typename F>
+void EytzingerDictionary<Key, Value>::range(const Key& lo, const Key& hi, F&& func) const {
+    Key k;
+    for (size_t i = lower_bound(lo); i != 0; i = successor(i)) {
+        const Record& r = m_records[i];
+        k.assign(m_blob, r.offset, r.length);
+        if (k > hi) break;
+        func(k, r.value);
+    }
+}
+
+template <typename Key, typename Value>
+template <typename F>
+void EytzingerDictionary<Key, Value>::forEach(F&& func) const {
+    Key k;
+    for (size_t i = first(); i != 0; i = successor(i)) {
+        const Record& r = m_records[i];
+        k.assign(m_blob, r.offset, r.length);
+        func(k, r.value);
+    }
+}
+
+template <typename Key, typename Value>
+int EytzingerDictionary<Key, Value>::size() const {
+    return static_cast<int>(m_n);
+}
+
+template <typename Key, typename Value>
+size_t EytzingerDictionary<Key, Value>::memory_usage() const {
+    return sizeof(*this) + m_prefix.size() * sizeof(Prefix) + m_records.size() * sizeof(Record) + m_blob.size();
+}
+
+// Exporta um dicionário já preenchido para a árvore de Eytzinger
+template <typename Key, typename Value, typename Dict>
+EytzingerDictionary<Key, Value> freezeOrdered(const Dict& dict) {
+    return EytzingerDictionary<Key, Value>(dict);
+}
+
+#endif // EYTZINGER_DICTIONARY_HPP
@@ -0,0 +1,281 @@
+#ifndef FROZEN_DICTIONARY_HPP
+#define FROZEN_DICTIONARY_HPP
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#include "HashFunctions.hpp"
+
+// Dicionário imutável sobre uma função hash perfeita mínima no estilo
+// PTHash: as chaves caem em ~c·n/log2(n) baldes e, do maior balde para o
+// menor, procura-se um "piloto" que leve todas as chaves do balde a
+// posições livres de uma tabela de m = n/α posições. Posições >= n são
+// remapeadas para as vagas que sobraram abaixo de n.
+// As chaves ficam contíguas num único bloco e cada posição guarda só
+// deslocamento, tamanho e contagem: uma busca toca os pilotos, um registro
+// e a chave, e faz uma única comparação.
+template <typename Key, typename Value, typename Hash = WyHash>
+class FrozenDictionary {
+    static_assert(std::is_same<Key, std::string>::value,
+                  "FrozenDictionary guarda apenas chaves std::string");
+public:
+    FrozenDictionary();
+
+    // Constrói a partir de qualquer dicionário com forEach(key, value)
+    template <typename Dict>
+    explicit FrozenDictionary(const Dict& dict);
+
+    Value get(const Key& k) const;
+    bool contains(const Key& k) const;
+    template <typename F>
+    void forEach(F&& func) const;
+    int size() const;
+
+    double bits_per_key() const;   // só a função hash (pilotos + remapeamento)
+    size_t memory_usage() const;   // estrutura inteira, em bytes
+
+private:
+    static constexpr double BUCKET_FACTOR = 6.0;  // c
+    static constexpr double ALPHA = 0.99;         // n / m
+    static constexpr uint32_t MAX_PILOT = UINT16_MAX;
+    static constexpr int MAX_SEEDS = 64;          // tentativas antes de desistir
+
+    uint64_t m_seed;
+    size_t m_n;
+    size_t m_table_size;                 // m
+    std::vector<uint16_t> m_pilots;      // um por balde
+    std::vector<uint32_t> m_remap;       // posição (p - n) -> vaga < n
+
+    struct Slot {
+        uint32_t offset;                 // início da chave em m_blob
+        uint32_t length;
+        Value value;
+    };
+
+    std::string m_blob;                  // chaves concatenadas, na ordem das posições
+    std::vector<Slot> m_slots;
+    Hash m_hashing;
+
+    uint64_t key_hash(const Key& k) const;
+    size_t bucket_of(uint64_t h) const;
+    size_t position(uint64_t h, uint32_t pilot) const;
+    size_t slot_of(const Key& k) const;
+    bool try_build(const std::vector<std::pair<Key, Value>>& entries, uint64_t seed);
+
+    static uint64_t fast_range(uint64_t h, uint64_t n);
+};
+
+template <typename Key, typename Value, typename Hash>
+FrozenDictionary<Key, Value, Hash>::FrozenDictionary() {
+    m_seed = 0;
+    m_n = m_table_size = 0;
+}
+
+template <typename Key, typename Value, typename Hash>
+template <typename Dict>
+FrozenDictionary<Key, Value, Hash>::FrozenDictionary(const Dict& dict) : FrozenDictionary() {
+    std::vector<std::pair<Key, Value>> entries;
+    entries.reserve(dict.size());
+    dict.forEach([&](const Key& k, const Value& v) {
+        entries.emplace_back(k, v);
+    });
+    if (entries.size() > UINT32_MAX) throw std::length_error("chaves demais para o dicionário congelado");
+
+    // A semente só entra depois da política de hash: chaves distintas com o
+    // mesmo hash base colidem sob qualquer semente, então isso é recusado
+    // logo, antes de tentar
+    {
+        std::vector<uint64_t> base(entries.size());
+        for (size_t i = 0; i < entries.size(); i++) base[i] = m_hashing(entries[i].first);
+        std::sort(base.begin(), base.end());
+        if (std::adjacent_find(base.begin(), base.end()) != base.end()) {
+            throw std::runtime_error("Política de hash dá o mesmo valor para chaves distintas; "
+                                     "congele com outra (ex.: WyHash)");
+        }
+    }
+
+    // Uma semente ruim (colisão após a mistura ou piloto grande demais) só
+    // exige outra tentativa
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+    for (int attempt = 0; !try_build(entries, seed); attempt++) {
+        if (attempt + 1 >= MAX_SEEDS) throw std::runtime_error("Não foi possível construir o dicionário congelado");
+        seed = hash_detail::mum(seed, 0xD6E8FEB86659FD93ULL) + 1;
+    }
+}
+
+template <typename Key, typename Value, typename Hash>
+Value FrozenDictionary<Key, Value, Hash>::get(const Key& k) const {
+    size_t slot = slot_of(k);
+    if (slot == m_n) throw std::runtime_error("Chave não encontrada");
+    return m_slots[slot].value;
+}
+
+template <typename Key, typename Value, typename Hash>
+bool FrozenDictionary<Key, Value, Hash>::contains(const Key& k) const {
+    return slot_of(k) != m_n;
+}
+
+template <typename Key, typename Value, typename Hash>
+template <typename F>
+void FrozenDictionary<Key, Value, Hash>::forEach(F&& func) const {
+    Key k;
+    for (size_t i = 0; i < m_n; i++) {
+        k.assign(m_blob, m_slots[i].offset, m_slots[i].length);
+        func(k, m_slots[i].value);
+    }
+}
+
+template <typename Key, typename Value, typename Hash>
+int FrozenDictionary<Key, Value, Hash>::size() const {
+    return static_cast<int>(m_n);
+}
+
+template <typename Key, typename Value, typename Hash>
+double FrozenDictionary<Key, Value, Hash>::bits_per_key() const {
+    if (m_n == 0) return 0;
+    return (m_pilots.size() * 16.0 + m_remap.size() * 32.0) / m_n;
+}
+
+template <typename Key, typename Value, typename Hash>
+size_t FrozenDictionary<Key, Value, Hash>::memory_usage() const {
+    return sizeof(*this) + m_pilots.size() * sizeof(uint16_t) + m_remap.size() * sizeof(uint32_t) +
+           m_blob.size() + m_slots.size() * sizeof(Slot);
+}
+
+// Devolve a posição da chave, ou m_n quando ela não está no dicionário
+template <typename Key, typename Value, typename Hash>
+size_t FrozenDictionary<Key, Value, Hash>::slot_of(const Key& k) const {
+    if (m_n == 0) return m_n;
+    uint64_t h = key_hash(k);
+    size_t p = position(h, m_pilots[bucket_of(h)]);
+    if (p >= m_n) p = m_remap[p - m_n];
+    const Slot& s = m_slots[p];
+    if (s.length != k.size() || std::memcmp(m_blob.data() + s.offset, k.data(), s.length) != 0) return m_n;
+    return p;
+}
+
+template <typename Key, typename Value, typename Hash>
+bool FrozenDictionary<Key, Value, Hash>::try_build(const std::vector<std::pair<Key, Value>>& entries, uint64_t seed) {
+    m_seed = seed;
+    m_n = entries.size();
+    m_table_size = std::max<size_t>(m_n, static_cast<size_t>(std::ceil(m_n / ALPHA)));
+    double log_n = std::max(1.0, std::log2(static_cast<double>(std::max<size_t>(m_n, 2))));
+    size_t num_buckets = std::max<size_t>(1, static_cast<size_t>(std::ceil(BUCKET_FACTOR * m_n / log_n)));
+    m_pilots.assign(num_buckets, 0);
+
+    std::vector<uint64_t> hashes(m_n);
+    for (size_t i = 0; i < m_n; i++) hashes[i] = key_hash(entries[i].first);
+
+    // Chaves agrupadas por balde (ordenação por contagem)
+    std::vector<uint32_t> start(num_buckets + 1, 0);
+    for (size_t i = 0; i < m_n; i++) start[bucket_of(hashes[i]) + 1]++;
+    for (size_t b = 0; b < num_buckets; b++) start[b + 1] += start[b];
+    std::vector<uint32_t> members(m_n);
+    {
+        std::vector<uint32_t> fill(start.begin(), start.end() - 1);
+        for (size_t i = 0; i < m_n; i++) members[fill[bucket_of(hashes[i])]++] = static_cast<uint32_t>(i);
+    }
+
+    // Maiores baldes primeiro: são os mais difíceis de encaixar
+    std::vector<uint32_t> order(num_buckets);
+    for (size_t b = 0; b < num_buckets; b++) order[b] = static_cast<uint32_t>(b);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return start[a + 1] - start[a] > start[b + 1] - start[b];
+    });
+
+    std::vector<bool> taken(m_table_size, false);
+    std::vector<size_t> placed;
+    std::vector<size_t> slot_of_entry(m_n);
+    for (uint32_t b : order) {
+        uint32_t first = start[b], count = start[b + 1] - first;
+        if (count == 0) break;
+        uint32_t pilot = 0;
+        for (;; pilot++) {
+            // Chaves com o mesmo hash nunca se separam: troca a semente
+            if (pilot > MAX_PILOT) return false;
+            placed.clear();
+            bool ok = true;
+            for (uint32_t j = 0; j < count && ok; j++) {
+                size_t p = position(hashes[members[first + j]], pilot);
+                if (taken[p] || std::find(placed.begin(), placed.end(), p) != placed.end()) ok = false;
+                else placed.push_back(p);
+            }
+            if (ok) break;
+        }
+        m_pilots[b] = static_cast<uint16_t>(pilot);
+        for (uint32_t j = 0; j < count; j++) {
+            taken[placed[j]] = true;
+            slot_of_entry[members[first + j]] = placed[j];
+        }
+    }
+
+    // Posições >= n apontam para as vagas livres < n, em ordem
+    m_remap.assign(m_table_size - m_n, 0);
+    size_t free_slot = 0;
+    for (size_t p = m_n; p < m_table_size; p++) {
+        if (!taken[p]) continue;
+        while (taken[free_slot]) free_slot++;
+        m_remap[p - m_n] = static_cast<uint32_t>(free_slot++);
+    }
+
+    std::vector<uint32_t> entry_at(m_n);
+    for (size_t i = 0; i < m_n; i++) {
+        size_t p = slot_of_entry[i];
+        if (p >= m_n) p = m_remap[p - m_n];
+        entry_at[p] = static_cast<uint32_t>(i);
+    }
+
+    m_blob.clear();
+    m_slots.clear();
+    m_slots.reserve(m_n);
+    for (size_t p = 0; p < m_n; p++) {
+        const auto& e = entries[entry_at[p]];
+        if (m_blob.size() + e.first.size() > UINT32_MAX) throw std::length_error("chaves longas demais para o dicionário congelado");
+        m_slots.push_back(Slot{static_cast<uint32_t>(m_blob.size()), static_cast<uint32_t>(e.first.size()), e.second});
+        m_blob += e.first;
+    }
+    m_blob.shrink_to_fit();
+    return true;
+}
+
+template <typename Key, typename Value, typename Hash>
+uint64_t FrozenDictionary<Key, Value, Hash>::key_hash(const Key& k) const {
+    return hash_detail::mum(static_cast<uint64_t>(m_hashing(k)) ^ m_seed, 0x9FB21C651E98DF25ULL);
+}
+
+template <typename Key, typename Value, typename Hash>
+size_t FrozenDictionary<Key, Value, Hash>::bucket_of(uint64_t h) const {
+    return fast_range(h, m_pilots.size());
+}
+
+template <typename Key, typename Value, typename Hash>
+size_t FrozenDictionary<Key, Value, Hash>::position(uint64_t h, uint32_t pilot) const {
+    uint64_t ph = hash_detail::mum(pilot ^ m_seed, 0xC2B2AE3D27D4EB4FULL);
+    return fast_range(hash_detail::avalanche(h ^ ph), m_table_size);
+}
+
+// Redução de intervalo sem divisão: (h * n) / 2^64
+template <typename Key, typename Value, typename Hash>
+uint64_t FrozenDictionary<Key, Value, Hash>::fast_range(uint64_t h, uint64_t n) {
+#ifdef __SIZEOF_INT128__
+    return static_cast<uint64_t>((static_cast<unsigned __int128>(h) * n) >> 64);
+#else
+    return h % n;
+#endif
+}
+
+// Congela um dicionário já preenchido
+template <typename Key, typename Value, typename Hash = WyHash, typename Dict>
+FrozenDictionary<Key, Value, Hash> freeze(const Dict& dict) {
+    return FrozenDictionary<Key, Value, Hash>(dict);
+}
+
+#endif // FROZEN_DICTIONARY_HPP
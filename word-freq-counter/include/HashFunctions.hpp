@@ -0,0 +1,184 @@
+#ifndef HASH_FUNCTIONS_HPP
+#define HASH_FUNCTIONS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+
+// Políticas de hash para chaves std::string, usadas como argumento Hash
+// das tabelas. Todas devolvem 64 bits bem misturados, já que o índice do
+// balde vem de FastMod sobre o valor inteiro.
+
+namespace hash_detail {
+
+inline uint64_t read64(const char* p) {
+    uint64_t v;
+    std::memcpy(&v, p, 8);
+    return v;
+}
+
+inline uint64_t read32(const char* p) {
+    uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
+
+// Multiplicação 64x64 -> 128 dobrada em 64 bits (o "mum" do wyhash)
+inline uint64_t mum(uint64_t a, uint64_t b) {
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+    return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+#else
+    uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32), c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+    return lo ^ hi;
+#endif
+}
+
+inline uint64_t avalanche(uint64_t h) {
+    h ^= h >> 37;
+    h *= 0x165667919E3779F9ULL;
+    h ^= h >> 32;
+    return h;
+}
+
+} // namespace hash_detail
+
+// FNV-1a de 64 bits: um byte por iteração, simples e sem leituras largas
+struct FnvHash {
+    size_t operator()(const std::string& s) const {
+        uint64_t h = 0xcbf29ce484222325ULL;
+        for (unsigned char c : s) {
+            h ^= c;
+            h *= 0x100000001b3ULL;
+        }
+        return h;
+    }
+};
+
+// No estilo do wyhash: blocos de 8 bytes misturados por multiplicação de 128 bits
+struct WyHash {
+    size_t operator()(const std::string& s) const {
+        using namespace hash_detail;
+        static const uint64_t p0 = 0xa0761d6478bd642fULL, p1 = 0xe7037ed1a0b428dbULL,
+                              p2 = 0x8ebc6af09c88c6e3ULL;
+        const char* p = s.data();
+        size_t len = s.size();
+        uint64_t seed = p0, a, b;
+        if (len <= 16) {
+            if (len >= 4) {
+                a = (read32(p) << 32) | read32(p + ((len >> 3) << 2));
+                b = (read32(p + len - 4) << 32) | read32(p + len - 4 - ((len >> 3) << 2));
+            } else if (len > 0) {
+                a = (static_cast<uint64_t>(static_cast<unsigned char>(p[0])) << 16) |
+                    (static_cast<uint64_t>(static_cast<unsigned char>(p[len >> 1])) << 8) |
+                    static_cast<unsigned char>(p[len - 1]);
+                b = 0;
+            } else {
+                a = b = 0;
+            }
+        } else {
+            size_t i = len;
+            while (i > 16) {
+                seed = mum(read64(p) ^ p1, read64(p + 8) ^ seed);
+                p += 16;
+                i -= 16;
+            }
+            a = read64(p + i - 16);
+            b = read64(p + i - 8);
+        }
+        return mum(p1 ^ len, mum(a ^ p1, b ^ seed) ^ p2);
+    }
+};
+
+// No estilo do XXH3: faixas de 8 bytes acumuladas com primos e avalanche final
+struct Xxh3Hash {
+    size_t operator()(const std::string& s) const {
+        using namespace hash_detail;
+        static const uint64_t P1 = 0x9E3779B185EBCA87ULL, P2 = 0xC2B2AE3D27D4EB4FULL,
+                              P3 = 0x165667B19E3779F9ULL;
+        const char* p = s.data();
+        size_t len = s.size();
+        uint64_t acc = len * P1;
+        if (len <= 8) {
+            if (len >= 4) {
+                uint64_t in = read32(p) + (read32(p + len - 4) << 32);
+                acc ^= in * P2;
+            } else if (len > 0) {
+                uint64_t in = static_cast<unsigned char>(p[0]) |
+                              (static_cast<uint64_t>(static_cast<unsigned char>(p[len >> 1])) << 8) |
+                              (static_cast<uint64_t>(static_cast<unsigned char>(p[len - 1])) << 16);
+                acc ^= in * P3;
+            }
+            return avalanche(acc);
+        }
+        size_t i = 0;
+        for (; i + 8 <= len; i += 8) {
+            acc += mum(read64(p + i) ^ P2, P3 + i);
+        }
+        acc += mum(read64(p + len - 8) ^ P1, P2 ^ len);
+        return avalanche(acc);
+    }
+};
+
+// Para palavras curtas (até 16 bytes, quase todo o vocabulário): duas
+// leituras largas sobrepostas cobrem a palavra inteira sem laço, e uma única
+// multiplicação de 128 bits mistura o resultado. Palavras maiores caem no WyHash.
+struct ShortWordHash {
+    size_t operator()(const std::string& s) const {
+        using namespace hash_detail;
+        const char* p = s.data();
+        size_t len = s.size();
+        uint64_t lo, hi;
+        if (len > 16) {
+            return WyHash()(s);
+        } else if (len >= 8) {
+            lo = read64(p);
+            hi = read64(p + len - 8);
+        } else if (len >= 4) {
+            lo = read32(p) | (read32(p + len - 4) << 32);
+            hi = 0;
+        } else if (len > 0) {
+            lo = static_cast<unsigned char>(p[0]) |
+                 (static_cast<uint64_t>(static_cast<unsigned char>(p[len >> 1])) << 8) |
+                 (static_cast<uint64_t>(static_cast<unsigned char>(p[len - 1])) << 16);
+            hi = 0;
+        } else {
+            lo = hi = 0;
+        }
+        return mum(lo ^ 0x2d358dccaa6c78a5ULL ^ len, hi ^ 0x8bb84b93962eacc9ULL);
+    }
+};
+
+// Chave inteira de 128 bits, para quando 64 não bastam (ex.: n-gramas de
+// três ou quatro ids de 32 bits)
+struct Key128 {
+    uint64_t lo = 0;
+    uint64_t hi = 0;
+
+    bool operator==(const Key128& o) const { return lo == o.lo && hi == o.hi; }
+    bool operator!=(const Key128& o) const { return !(*this == o); }
+};
+
+// Para chaves inteiras: ids empacotados têm quase todos os bits altos
+// zerados, então uma multiplicação de 128 bits espalha a entropia por
+// todo o resultado antes de a tabela usar os bits baixos
+struct IntHash {
+    size_t operator()(uint64_t k) const {
+        return hash_detail::mum(k ^ 0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL);
+    }
+    size_t operator()(const Key128& k) const {
+        return hash_detail::mum(k.lo ^ 0x2d358dccaa6c78a5ULL, k.hi ^ 0x8bb84b93962eacc9ULL);
+    }
+};
+
+// Política padrão da biblioteca, para comparação
+using StdHash = std::hash<std::string>;
+
+#endif // HASH_FUNCTIONS_HPP
@@ -0,0 +1,49 @@
+#ifndef HASH_UTILS_HPP
+#define HASH_UTILS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <iterator>
+
+// Tamanhos de tabela primos, crescendo em passos de ~sqrt(2) até o maior
+// primo de 32 bits. Substitui a busca por divisão a cada crescimento.
+static constexpr uint32_t PRIME_SIZES[] = {
+    3u, 5u, 11u, 17u, 23u, 37u, 47u, 67u, 97u, 137u, 191u, 271u, 383u, 547u,
+    769u, 1087u, 1543u, 2179u, 3079u, 4349u, 6143u, 8689u, 12289u, 17377u,
+    24593u, 34757u, 49157u, 69539u, 98317u, 139033u, 196613u, 278051u,
+    393241u, 556093u, 786431u, 1112197u, 1572869u, 2224367u, 3145739u,
+    4448749u, 6291469u, 8897467u, 12582917u, 17794949u, 25165843u,
+    35589877u, 50331653u, 71179699u, 100663291u, 142359391u, 201326611u,
+    284718773u, 402653171u, 569437541u, 805306301u, 1138875079u,
+    1610612581u, 2277750149u, 3221225153u, 4294967291u
+};
+
+// Menor primo da tabela que seja >= x
+inline uint32_t next_prime_size(size_t x) {
+    const uint32_t* last = std::end(PRIME_SIZES) - 1;
+    if (x >= *last) return *last;
+    return *std::lower_bound(std::begin(PRIME_SIZES), last, x);
+}
+
+// Módulo por divisor fixo sem instrução de divisão (Lemire, "Faster
+// Remainder by Direct Computation"). O hash de 64 bits é dobrado em 32.
+struct FastMod {
+    uint32_t d;
+    uint64_t M;
+
+    FastMod() : d(1), M(0) {}
+    explicit FastMod(uint32_t divisor) : d(divisor), M(UINT64_MAX / divisor + 1) {}
+
+    uint32_t operator()(uint64_t h) const {
+        uint32_t a = static_cast<uint32_t>(h ^ (h >> 32));
+#ifdef __SIZEOF_INT128__
+        uint64_t low = M * a;
+        return static_cast<uint32_t>((static_cast<unsigned __int128>(low) * d) >> 64);
+#else
+        return a % d;
+#endif
+    }
+};
+
+#endif // HASH_UTILS_HPP
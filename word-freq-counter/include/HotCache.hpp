@@ -0,0 +1,148 @@
+#ifndef HOT_CACHE_HPP
+#define HOT_CACHE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+// Acertos e falhas do cache de chaves quentes
+struct HotCacheStats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t invalidations = 0;
+
+    double hit_rate() const {
+        return hits + misses == 0 ? 0.0 : double(hits) / (hits + misses);
+    }
+
+    void print(std::ostream& out) const {
+        out << "cache quente: " << hits << " acertos, " << misses << " falhas ("
+            << hit_rate() * 100 << "%), " << invalidations << " invalidações\n";
+    }
+};
+
+// Cache associativo de 2 vias, indexado pelo hash da chave, que aponta
+// direto para a chave e o valor de um nó da árvore. Um acerto dispensa a
+// descida inteira com comparações de string. As entradas só guardam
+// ponteiros, então a árvore deve invalidar a chave antes de liberar o nó
+// ou mover o conteúdo dele para outro. Só as escritas da árvore (insert,
+// insert_or_get) preenchem o cache e mexem nas estatísticas; as leituras
+// usam peek, que não escreve nada, e podem rodar em várias threads.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class HotCache {
+public:
+    // sets é arredondado para potência de 2
+    explicit HotCache(size_t sets = 256);
+
+    size_t hash(const Key& k) const;
+    // Valor da chave k (de hash h), ou nullptr se não estiver no cache
+    Value* find(const Key& k, size_t h);
+    // Como find, mas sem atualizar a via substituída nem as estatísticas
+    const Value* peek(const Key& k, size_t h) const;
+    // Guarda o nó recém-acessado no lugar da entrada menos recente do conjunto
+    void put(size_t h, const Key* key, Value* value);
+    void invalidate(const Key& k);
+    void clear();
+
+    size_t sets() const;
+    const HotCacheStats& stats() const;
+
+private:
+    struct Entry {
+        size_t hash;
+        const Key* key;     // nullptr = entrada vazia
+        Value* value;
+    };
+
+    struct Set {
+        Entry way[2];
+        unsigned char victim;   // via a substituir na próxima falha
+    };
+
+    std::vector<Set> m_sets;
+    size_t m_mask;
+    Hash m_hash;
+    HotCacheStats m_stats;
+};
+
+template <typename Key, typename Value, typename Hash>
+HotCache<Key, Value, Hash>::HotCache(size_t sets) {
+    size_t n = 1;
+    while (n < sets) n <<= 1;
+    m_sets.resize(n);
+    m_mask = n - 1;
+    clear();
+}
+
+template <typename Key, typename Value, typename Hash>
+size_t HotCache<Key, Value, Hash>::hash(const Key& k) const {
+    return m_hash(k);
+}
+
+template <typename Key, typename Value, typename Hash>
+Value* HotCache<Key, Value, Hash>::find(const Key& k, size_t h) {
+    Set& s = m_sets[h & m_mask];
+    for (unsigned char w = 0; w < 2; w++) {
+        const Entry& e = s.way[w];
+        if (e.key != nullptr && e.hash == h && *e.key == k) {
+            s.victim = w ^ 1;
+            m_stats.hits++;
+            return e.value;
+        }
+    }
+    m_stats.misses++;
+    return nullptr;
+}
+
+template <typename Key, typename Value, typename Hash>
+const Value* HotCache<Key, Value, Hash>::peek(const Key& k, size_t h) const {
+    const Set& s = m_sets[h & m_mask];
+    for (unsigned char w = 0; w < 2; w++) {
+        const Entry& e = s.way[w];
+        if (e.key != nullptr && e.hash == h && *e.key == k) return e.value;
+    }
+    return nullptr;
+}
+
+template <typename Key, typename Value, typename Hash>
+void HotCache<Key, Value, Hash>::put(size_t h, const Key* key, Value* value) {
+    Set& s = m_sets[h & m_mask];
+    unsigned char w = s.victim;
+    s.way[w] = Entry{h, key, value};
+    s.victim = w ^ 1;
+}
+
+template <typename Key, typename Value, typename Hash>
+void HotCache<Key, Value, Hash>::invalidate(const Key& k) {
+    size_t h = m_hash(k);
+    Set& s = m_sets[h & m_mask];
+    for (unsigned char w = 0; w < 2; w++) {
+        Entry& e = s.way[w];
+        if (e.key != nullptr && e.hash == h && *e.key == k) {
+            e.key = nullptr;
+            s.victim = w;
+            m_stats.invalidations++;
+        }
+    }
+}
+
+template <typename Key, typename Value, typename Hash>
+void HotCache<Key, Value, Hash>::clear() {
+    for (auto& s : m_sets) {
+        s.way[0].key = s.way[1].key = nullptr;
+        s.victim = 0;
+    }
+}
+
+template <typename Key, typename Value, typename Hash>
+size_t HotCache<Key, Value, Hash>::sets() const {
+    return m_sets.size();
+}
+
+template <typename Key, typename Value, typename Hash>
+const HotCacheStats& HotCache<Key, Value, Hash>::stats() const {
+    return m_stats;
+}
+
+#endif // HOT_CACHE_HPP
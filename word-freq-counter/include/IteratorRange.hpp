@@ -0,0 +1,15 @@
+#ifndef ITERATOR_RANGE_HPP
+#define ITERATOR_RANGE_HPP
+
+// Par [first, last) de iteradores utilizável em range-for
+template <typename Iterator>
+struct IteratorRange {
+    Iterator first;
+    Iterator last;
+
+    Iterator begin() const { return first; }
+    Iterator end() const { return last; }
+    bool empty() const { return first == last; }
+};
+
+#endif // ITERATOR_RANGE_HPP
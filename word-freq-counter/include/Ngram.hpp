@@ -0,0 +1,120 @@
+#ifndef NGRAM_HPP
+#define NGRAM_HPP
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+#include "HashFunctions.hpp"
+#include "OpenAddressingHashTable.hpp"
+#include "Vocabulary.hpp"
+
+// Um n-grama é a tupla dos ids das suas palavras, 32 bits cada, empacotada
+// numa chave inteira com a palavra mais antiga nos bits altos: até dois ids
+// cabem em 64 bits, três ou quatro em 128. Avançar uma palavra é deslocar
+// a chave e colocar o novo id nos bits baixos.
+inline uint64_t shiftNgram(uint64_t key, uint32_t id, unsigned n) {
+    return n == 1 ? id : (key << 32) | id;
+}
+
+inline Key128 shiftNgram(Key128 key, uint32_t id, unsigned n) {
+    key.hi = (key.hi << 32) | (key.lo >> 32);
+    key.lo = (key.lo << 32) | id;
+    if (n == 3) key.hi &= 0xffffffffULL;
+    return key;
+}
+
+// Id da i-ésima palavra (0 = a mais antiga) de um n-grama empacotado
+inline uint32_t ngramId(uint64_t key, unsigned i, unsigned n) {
+    return static_cast<uint32_t>(key >> (32 * (n - 1 - i)));
+}
+
+inline uint32_t ngramId(const Key128& key, unsigned i, unsigned n) {
+    unsigned shift = 32 * (n - 1 - i);
+    return static_cast<uint32_t>(shift < 64 ? key.lo >> shift : key.hi >> (shift - 64));
+}
+
+// Conta as sequências de N palavras consecutivas. Dict interna as palavras
+// (palavra → id); as contagens ficam numa tabela de endereçamento aberto
+// pela chave empacotada, sem nenhuma string por n-grama.
+template <unsigned N, typename Dict>
+class NgramCounter {
+    static_assert(N >= 1 && N <= 4, "n-gramas de 1 a 4 palavras");
+
+public:
+    using Key = typename std::conditional<(N <= 2), uint64_t, Key128>::type;
+
+    // Conta o n-grama que termina nesta palavra, se já houver N palavras
+    void push(const std::string& word);
+    // Interrompe a sequência: nenhum n-grama atravessa o ponto (ex.: fim de arquivo)
+    void reset();
+
+    // n-gramas distintos e total contado
+    size_t size() const;
+    uint64_t total() const;
+    size_t vocabulary() const;
+
+    // Entrega cada n-grama distinto como texto, palavras separadas por espaço
+    void forEach(const std::function<void(const std::string&, int)>& func) const;
+
+    const OpenAddressingHashTable<Key, int>& table() const;
+
+private:
+    Vocabulary<Dict> m_vocabulary;
+    OpenAddressingHashTable<Key, int> m_counts;
+    Key m_key{};
+    unsigned m_filled = 0;
+    uint64_t m_total = 0;
+};
+
+template <unsigned N, typename Dict>
+void NgramCounter<N, Dict>::push(const std::string& word) {
+    m_key = shiftNgram(m_key, m_vocabulary.intern(word), N);
+    if (m_filled < N) m_filled++;
+    if (m_filled == N) {
+        m_counts.insert(m_key);
+        m_total++;
+    }
+}
+
+template <unsigned N, typename Dict>
+void NgramCounter<N, Dict>::reset() {
+    m_key = Key{};
+    m_filled = 0;
+}
+
+template <unsigned N, typename Dict>
+size_t NgramCounter<N, Dict>::size() const {
+    return m_counts.size();
+}
+
+template <unsigned N, typename Dict>
+uint64_t NgramCounter<N, Dict>::total() const {
+    return m_total;
+}
+
+template <unsigned N, typename Dict>
+size_t NgramCounter<N, Dict>::vocabulary() const {
+    return m_vocabulary.size();
+}
+
+template <unsigned N, typename Dict>
+void NgramCounter<N, Dict>::forEach(const std::function<void(const std::string&, int)>& func) const {
+    std::string text;
+    m_counts.forEach([&](const Key& key, const int& count) {
+        text.clear();
+        for (unsigned i = 0; i < N; i++) {
+            if (i > 0) text.push_back(' ');
+            text += m_vocabulary.word(ngramId(key, i, N));
+        }
+        func(text, count);
+    });
+}
+
+template <unsigned N, typename Dict>
+const OpenAddressingHashTable<typename NgramCounter<N, Dict>::Key, int>& NgramCounter<N, Dict>::table() const {
+    return m_counts;
+}
+
+#endif // NGRAM_HPP
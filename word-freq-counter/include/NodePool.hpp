@@ -0,0 +1,137 @@
+#ifndef NODE_POOL_HPP
+#define NODE_POOL_HPP
+
+#include <cstddef>
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Pool de nós de tamanho fixo: aloca blocos de posições (cada bloco com
+// ~1/4 da capacidade atual, limitando a sobra a 25%) e recicla as posições
+// liberadas por uma lista livre. O pool não conhece os objetos vivos; quem o usa deve liberar
+// (release) tudo antes de destruí-lo.
+template <typename T>
+class NodePool {
+public:
+    explicit NodePool(size_t first_chunk = 64);
+    ~NodePool();
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    template <typename... Args>
+    T* acquire(Args&&... args);
+    void release(T* p);
+
+    size_t capacity() const;
+    size_t bytes_reserved() const;
+
+    // Junta from a into: os blocos e a lista livre de from passam para into,
+    // e from encaminha acquire/release para ele daí em diante. Estruturas que
+    // trocam nós entre si (AVL::split, join, union_with) ficam assim com um
+    // único pool, mantido vivo enquanto qualquer uma delas existir.
+    static void merge(const std::shared_ptr<NodePool>& into, const std::shared_ptr<NodePool>& from);
+
+private:
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    std::vector<Slot*> m_chunks;
+    Slot* m_free;
+    size_t m_first_chunk;
+    size_t m_capacity;
+    std::shared_ptr<NodePool> m_forward;  // pool que absorveu este
+
+    static std::shared_ptr<NodePool> root(std::shared_ptr<NodePool> pool);
+
+    void grow();
+};
+
+template <typename T>
+NodePool<T>::NodePool(size_t first_chunk) {
+    m_free = nullptr;
+    m_first_chunk = first_chunk ? first_chunk : 1;
+    m_capacity = 0;
+}
+
+template <typename T>
+NodePool<T>::~NodePool() {
+    for (Slot* chunk : m_chunks) {
+        ::operator delete(chunk);
+    }
+}
+
+template <typename T>
+template <typename... Args>
+T* NodePool<T>::acquire(Args&&... args) {
+    if (m_forward) return m_forward->acquire(std::forward<Args>(args)...);
+    if (m_free == nullptr) grow();
+    Slot* slot = m_free;
+    m_free = slot->next;
+    return new (slot->storage) T(std::forward<Args>(args)...);
+}
+
+template <typename T>
+void NodePool<T>::release(T* p) {
+    if (p == nullptr) return;
+    if (m_forward) {
+        m_forward->release(p);
+        return;
+    }
+    p->~T();
+    Slot* slot = reinterpret_cast<Slot*>(p);
+    slot->next = m_free;
+    m_free = slot;
+}
+
+template <typename T>
+size_t NodePool<T>::capacity() const {
+    return m_capacity;
+}
+
+template <typename T>
+size_t NodePool<T>::bytes_reserved() const {
+    return capacity() * sizeof(Slot);
+}
+
+template <typename T>
+std::shared_ptr<NodePool<T>> NodePool<T>::root(std::shared_ptr<NodePool> pool) {
+    while (pool->m_forward) pool = pool->m_forward;
+    return pool;
+}
+
+template <typename T>
+void NodePool<T>::merge(const std::shared_ptr<NodePool>& into, const std::shared_ptr<NodePool>& from) {
+    std::shared_ptr<NodePool> a = root(into), b = root(from);
+    if (a == b) return;
+    a->m_chunks.insert(a->m_chunks.end(), b->m_chunks.begin(), b->m_chunks.end());
+    if (b->m_free != nullptr) {
+        Slot* tail = b->m_free;
+        while (tail->next != nullptr) tail = tail->next;
+        tail->next = a->m_free;
+        a->m_free = b->m_free;
+    }
+    a->m_capacity += b->m_capacity;
+    b->m_chunks.clear();
+    b->m_free = nullptr;
+    b->m_capacity = 0;
+    b->m_forward = a;
+}
+
+template <typename T>
+void NodePool<T>::grow() {
+    size_t n = std::max(m_first_chunk, m_capacity / 4);
+    Slot* chunk = static_cast<Slot*>(::operator new(n * sizeof(Slot)));
+    m_chunks.push_back(chunk);
+    for (size_t i = 0; i < n; i++) {
+        chunk[i].next = (i + 1 < n) ? &chunk[i + 1] : m_free;
+    }
+    m_free = chunk;
+    m_capacity += n;
+}
+
+#endif // NODE_POOL_HPP
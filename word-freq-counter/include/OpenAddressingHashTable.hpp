@@ -0,0 +1,189 @@
+#ifndef OPEN_ADDRESSING_HASHTABLE_HPP
+#define OPEN_ADDRESSING_HASHTABLE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#include "HashFunctions.hpp"
+
+// Tabela de sondagem linear para chaves inteiras pequenas (ids, ids
+// empacotados). Chave e valor ficam juntos no mesmo vetor de slots, sem nó
+// nem ponteiro: uma busca é uma sequência de slots vizinhos, quase sempre
+// na mesma linha de cache. A capacidade é potência de 2 e o índice vem dos
+// bits baixos do hash, por isso Hash precisa misturar bem (IntHash).
+template <typename Key, typename Value, typename Hash = IntHash>
+class OpenAddressingHashTable {
+public:
+    explicit OpenAddressingHashTable(size_t capacity = 16, float max_load_factor = 0.7f);
+
+    void insert(const Key& k);                  // insere com 1 ou incrementa
+    void update(const Key& k, const Value& new_value);
+    Value get(const Key& k) const;
+    bool remove(const Key& k);
+    bool contains(const Key& k) const;
+    void forEach(std::function<void(const Key&, const Value&)> func) const;
+    void clear();
+    void reserve(size_t n);
+    size_t size() const;
+    size_t capacity() const;
+    float load_factor() const;
+    size_t max_probe() const;                   // maior distância de um slot ao ideal
+
+private:
+    struct Slot {
+        Key key;
+        Value value;
+        bool used;
+    };
+
+    std::vector<Slot> m_slots;
+    size_t m_mask;
+    size_t m_size;
+    float m_max_load_factor;
+    Hash m_hashing;
+
+    size_t find(const Key& k) const;            // índice do slot, ou m_slots.size()
+    void grow(size_t capacity);
+};
+
+template <typename Key, typename Value, typename Hash>
+OpenAddressingHashTable<Key, Value, Hash>::OpenAddressingHashTable(size_t capacity, float max_load_factor)
+    : m_size(0), m_max_load_factor(max_load_factor <= 0 || max_load_factor >= 1 ? 0.7f : max_load_factor) {
+    size_t n = 16;
+    while (n < capacity) n <<= 1;
+    m_slots.assign(n, Slot{Key(), Value(), false});
+    m_mask = n - 1;
+}
+
+template <typename Key, typename Value, typename Hash>
+size_t OpenAddressingHashTable<Key, Value, Hash>::find(const Key& k) const {
+    for (size_t i = m_hashing(k) & m_mask;; i = (i + 1) & m_mask) {
+        const Slot& s = m_slots[i];
+        if (!s.used) return m_slots.size();
+        if (s.key == k) return i;
+    }
+}
+
+// Reinsere todos os slots numa tabela nova; a ordem de reinserção não
+// importa porque nenhuma chave está presente duas vezes
+template <typename Key, typename Value, typename Hash>
+void OpenAddressingHashTable<Key, Value, Hash>::grow(size_t capacity) {
+    std::vector<Slot> old(capacity, Slot{Key(), Value(), false});
+    old.swap(m_slots);
+    m_mask = capacity - 1;
+    for (const Slot& s : old) {
+        if (!s.used) continue;
+        size_t i = m_hashing(s.key) & m_mask;
+        while (m_slots[i].used) i = (i + 1) & m_mask;
+        m_slots[i] = s;
+    }
+}
+
+template <typename Key, typename Value, typename Hash>
+void OpenAddressingHashTable<Key, Value, Hash>::insert(const Key& k) {
+    size_t i = m_hashing(k) & m_mask;
+    for (;; i = (i + 1) & m_mask) {
+        Slot& s = m_slots[i];
+        if (!s.used) break;
+        if (s.key == k) {
+            s.value++;
+            return;
+        }
+    }
+    // Chave nova: cresce antes de ocupar o slot, se preciso, e sonda de novo
+    if (m_size + 1 > m_slots.size() * m_max_load_factor) {
+        grow(m_slots.size() * 2);
+        i = m_hashing(k) & m_mask;
+        while (m_slots[i].used) i = (i + 1) & m_mask;
+    }
+    m_slots[i] = Slot{k, 1, true};
+    m_size++;
+}
+
+template <typename Key, typename Value, typename Hash>
+void OpenAddressingHashTable<Key, Value, Hash>::update(const Key& k, const Value& new_value) {
+    size_t i = find(k);
+    if (i == m_slots.size()) throw std::runtime_error("Chave não encontrada para atualização");
+    m_slots[i].value = new_value;
+}
+
+template <typename Key, typename Value, typename Hash>
+Value OpenAddressingHashTable<Key, Value, Hash>::get(const Key& k) const {
+    size_t i = find(k);
+    if (i == m_slots.size()) throw std::runtime_error("Chave não encontrada");
+    return m_slots[i].value;
+}
+
+// Remoção sem lápide: os slots seguintes do mesmo agrupamento recuam para
+// o buraco sempre que isso não os coloca antes da posição ideal deles
+template <typename Key, typename Value, typename Hash>
+bool OpenAddressingHashTable<Key, Value, Hash>::remove(const Key& k) {
+    size_t hole = find(k);
+    if (hole == m_slots.size()) return false;
+    for (size_t j = (hole + 1) & m_mask; m_slots[j].used; j = (j + 1) & m_mask) {
+        size_t ideal = m_hashing(m_slots[j].key) & m_mask;
+        // j pode ir para hole se ideal não estiver em (hole, j], circularmente
+        if (((j - ideal) & m_mask) >= ((j - hole) & m_mask)) {
+            m_slots[hole] = m_slots[j];
+            hole = j;
+        }
+    }
+    m_slots[hole].used = false;
+    m_size--;
+    return true;
+}
+
+template <typename Key, typename Value, typename Hash>
+bool OpenAddressingHashTable<Key, Value, Hash>::contains(const Key& k) const {
+    return find(k) != m_slots.size();
+}
+
+template <typename Key, typename Value, typename Hash>
+void OpenAddressingHashTable<Key, Value, Hash>::forEach(std::function<void(const Key&, const Value&)> func) const {
+    for (const Slot& s : m_slots) {
+        if (s.used) func(s.key, s.value);
+    }
+}
+
+template <typename Key, typename Value, typename Hash>
+void OpenAddressingHashTable<Key, Value, Hash>::clear() {
+    for (Slot& s : m_slots) s.used = false;
+    m_size = 0;
+}
+
+template <typename Key, typename Value, typename Hash>
+void OpenAddressingHashTable<Key, Value, Hash>::reserve(size_t n) {
+    size_t capacity = m_slots.size();
+    while (n > capacity * m_max_load_factor) capacity <<= 1;
+    if (capacity != m_slots.size()) grow(capacity);
+}
+
+template <typename Key, typename Value, typename Hash>
+size_t OpenAddressingHashTable<Key, Value, Hash>::size() const {
+    return m_size;
+}
+
+template <typename Key, typename Value, typename Hash>
+size_t OpenAddressingHashTable<Key, Value, Hash>::capacity() const {
+    return m_slots.size();
+}
+
+template <typename Key, typename Value, typename Hash>
+float OpenAddressingHashTable<Key, Value, Hash>::load_factor() const {
+    return static_cast<float>(m_size) / m_slots.size();
+}
+
+template <typename Key, typename Value, typename Hash>
+size_t OpenAddressingHashTable<Key, Value, Hash>::max_probe() const {
+    size_t worst = 0;
+    for (size_t i = 0; i < m_slots.size(); i++) {
+        if (!m_slots[i].used) continue;
+        worst = std::max(worst, (i - (m_hashing(m_slots[i].key) & m_mask)) & m_mask);
+    }
+    return worst;
+}
+
+#endif // OPEN_ADDRESSING_HASHTABLE_HPP
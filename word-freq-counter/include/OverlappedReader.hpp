@@ -0,0 +1,67 @@
+#ifndef OVERLAPPED_READER_HPP
+#define OVERLAPPED_READER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Opções do estágio de leitura
+struct ReadOptions {
+    size_t buffer_size = 1 << 20;   // bytes por buffer (múltiplo de 4 KiB)
+    size_t buffers = 4;             // tamanho do anel
+    bool direct_io = false;         // O_DIRECT, ignorado se o sistema de arquivos recusar
+};
+
+// Lê um arquivo (ou o trecho [begin, end) dele) numa thread separada, com
+// pread em buffers grandes e alinhados, e os entrega em ordem por um anel
+// limitado. Enquanto o consumidor processa um buffer, a thread já está
+// lendo os próximos. Trechos que cabem num único buffer são lidos na
+// própria thread do consumidor, sem criar outra.
+class OverlappedReader {
+public:
+    explicit OverlappedReader(const std::string& filepath, const ReadOptions& options = ReadOptions(),
+                              uint64_t begin = 0, uint64_t end = UINT64_MAX);
+    ~OverlappedReader();
+
+    OverlappedReader(const OverlappedReader&) = delete;
+    OverlappedReader& operator=(const OverlappedReader&) = delete;
+
+    // Espera o próximo buffer cheio; false no fim do arquivo.
+    // O buffer continua válido até a próxima chamada.
+    bool next(const char*& data, size_t& length);
+
+private:
+    struct Buffer {
+        char* data;
+        size_t start;       // bytes antes de 'begin' (leitura alinhada)
+        size_t length;
+    };
+
+    int m_fd;
+    bool m_direct;
+    bool m_sync;            // um só buffer, sem thread leitora
+    size_t m_buffer_size;
+    uint64_t m_offset;      // próximo deslocamento a ler
+    uint64_t m_begin;
+    uint64_t m_end;
+    std::vector<Buffer> m_ring;
+    size_t m_filled;        // buffers produzidos
+    size_t m_consumed;      // buffers devolvidos
+    bool m_holding;         // o consumidor está com um buffer
+    bool m_eof;
+    bool m_stop;
+    std::string m_error;
+    std::mutex m_lock;
+    std::condition_variable m_has_data;
+    std::condition_variable m_has_space;
+    std::thread m_thread;
+
+    void run();
+    bool fill(Buffer& b, bool& eof, std::string& error);
+};
+
+#endif
@@ -2,9 +2,17 @@
 #define RED_BLACK_TREE_HPP
 
 #include "Node.hpp"
+#include "IteratorRange.hpp"
+#include "Stats.hpp"
+#include "NodePool.hpp"
+#include "HotCache.hpp"
 #include <iostream>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
 
-template <typename Key, typename Value>
+template <typename Key, typename Value, bool OrderStatistics = false, typename Stats = NoStats>
 class RedBlackTree {
 private:
     Node<Key, Value>* m_root;
@@ -12,90 +20,231 @@ private:
     
     int m_size;
 
-    int left_rotates, right_rotates;
-    mutable size_t key_comparisons;
+    mutable Stats m_stats;
+    NodePool<Node<Key, Value>> m_pool;  // nós removidos são reaproveitados
+    std::unique_ptr<HotCache<Key, Value>> m_cache;
 
     static constexpr bool RED = 0;
     static constexpr bool BLACK = 1;
 
 public:
+    class const_iterator;
+    using iterator = const_iterator;
+
     RedBlackTree();
     ~RedBlackTree();
     void insert(const Key& key);
+    // Valor de key, inserindo-a com value se ausente, numa só descida
+    Value insert_or_get(const Key& key, const Value& value);
     void update(const Key& key, const Value& new_value);
     Value get(const Key& key) const;
     void remove(const Key& key);
+    bool decrement(const Key& key);
     bool contains(const Key& key) const;
-    void forEach(std::function<void(const Key&, const Value&)> func) const;
+    size_t get_batch(const Key* keys, size_t n, Value* out, const Value& missing = Value()) const;
+    size_t contains_batch(const Key* keys, size_t n, bool* out) const;
+    template <typename F>
+    void forEach(F&& func) const;
     int size() const;
     void clear();
     void print(std::ostream& out = std::cout) const;
     size_t get_comparisons() const;
+    StatsReport stats() const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator lower_bound(const Key& key) const;
+    const_iterator upper_bound(const Key& key) const;
+    IteratorRange<const_iterator> range(const Key& lo, const Key& hi) const;
+
+    // Estatísticas de ordem em O(log n); exigem OrderStatistics = true
+    int rank(const Key& key) const;
+    Key select(int k) const;
+    int count_range(const Key& lo, const Key& hi) const;
+
+    // Cache de chaves quentes na frente da árvore; 0 conjuntos o desliga.
+    // Só insert e insert_or_get o preenchem: get apenas consulta, e leituras
+    // concorrentes de uma árvore pronta continuam seguras
+    void set_hot_cache(size_t sets);
+    HotCacheStats hot_cache_stats() const;
 
 private:
+    Node<Key, Value>* place(const Key& key);
     Node<Key, Value>* rotateLeft(Node<Key, Value>* x);
     Node<Key, Value>* rotateRight(Node<Key, Value>* y);
     void insertFixup(Node<Key, Value>* z);
+    void recolor(Node<Key, Value>* node, bool color);
     void printInOrder(Node<Key, Value>* node, std::ostream& out) const;
     void transplant(Node<Key, Value>* u, Node<Key, Value>* v);
     Node<Key, Value>* minimum(Node<Key, Value>* node) const;
+    Node<Key, Value>* maximum(Node<Key, Value>* node) const;
     void deleteFixup(Node<Key, Value>* x);
+    const_iterator bound(const Key& key, bool inclusive) const;
+    int count_less(const Key& key, bool inclusive) const;
+    template <typename Emit>
+    size_t lookup_batch(const Key* keys, size_t n, Emit&& emit) const;
+
+    static constexpr size_t BATCH_GROUP = 8; // descidas intercaladas por lote
+};
+
+// Iterador bidirecional em ordem, guiado pelos ponteiros para o pai.
+// end() é representado pelo sentinela m_nil.
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+class RedBlackTree<Key, Value, OrderStatistics, Stats>::const_iterator {
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Node<Key, Value>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Node<Key, Value>*;
+    using reference = const Node<Key, Value>&;
+
+    const_iterator() : m_node(nullptr), m_tree(nullptr) {}
+
+    reference operator*() const { return *m_node; }
+    pointer operator->() const { return m_node; }
+
+    const_iterator& operator++() {
+        Node<Key, Value>* nil = m_tree->m_nil;
+        if (m_node->right != nil) {
+            m_node = m_tree->minimum(m_node->right);
+            return *this;
+        }
+        Node<Key, Value>* parent = m_node->p;
+        while (parent != nil && m_node == parent->right) {
+            m_node = parent;
+            parent = parent->p;
+        }
+        m_node = parent;
+        return *this;
+    }
+
+    const_iterator& operator--() {
+        Node<Key, Value>* nil = m_tree->m_nil;
+        if (m_node == nil) {
+            if (m_tree->m_root != nil) m_node = m_tree->maximum(m_tree->m_root);
+            return *this;
+        }
+        if (m_node->left != nil) {
+            m_node = m_tree->maximum(m_node->left);
+            return *this;
+        }
+        Node<Key, Value>* parent = m_node->p;
+        while (parent != nil && m_node == parent->left) {
+            m_node = parent;
+            parent = parent->p;
+        }
+        m_node = parent;
+        return *this;
+    }
+
+    const_iterator operator++(int) { const_iterator tmp = *this; ++*this; return tmp; }
+    const_iterator operator--(int) { const_iterator tmp = *this; --*this; return tmp; }
+
+    bool operator==(const const_iterator& other) const { return m_node == other.m_node; }
+    bool operator!=(const const_iterator& other) const { return m_node != other.m_node; }
+
+private:
+    friend class RedBlackTree<Key, Value, OrderStatistics, Stats>;
+
+    Node<Key, Value>* m_node;
+    const RedBlackTree<Key, Value, OrderStatistics, Stats>* m_tree;
+
+    const_iterator(Node<Key, Value>* node, const RedBlackTree<Key, Value, OrderStatistics, Stats>* tree)
+        : m_node(node), m_tree(tree) {}
 };
 
-template <typename Key, typename Value>
-RedBlackTree<Key, Value>::RedBlackTree() {
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+RedBlackTree<Key, Value, OrderStatistics, Stats>::RedBlackTree() {
     m_nil = new Node<Key, Value>();
     m_nil->color = BLACK;
+    m_nil->size = 0;
     m_nil->left = m_nil->right = m_nil->p = m_nil;
     m_root = m_nil;
-    m_size = left_rotates = right_rotates = key_comparisons = 0;
+    m_size = 0;
 }
 
-template <typename Key, typename Value>
-RedBlackTree<Key, Value>::~RedBlackTree() {
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+RedBlackTree<Key, Value, OrderStatistics, Stats>::~RedBlackTree() {
     clear();
+    delete m_nil;
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+void RedBlackTree<Key, Value, OrderStatistics, Stats>::insert(const Key& key) {
+    size_t h = 0;
+    if (m_cache) {
+        h = m_cache->hash(key);
+        if (Value* value = m_cache->find(key, h)) {
+            ++*value;
+            return;
+        }
+    }
+    int before = m_size;
+    Node<Key, Value>* node = place(key);
+    if (m_size == before) node->value++;
+    if (m_cache) m_cache->put(h, &node->key, &node->value);
 }
 
-template <typename Key, typename Value>
-void RedBlackTree<Key, Value>::insert(const Key& key) {
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+Value RedBlackTree<Key, Value, OrderStatistics, Stats>::insert_or_get(const Key& key, const Value& value) {
+    size_t h = 0;
+    if (m_cache) {
+        h = m_cache->hash(key);
+        if (Value* found = m_cache->find(key, h)) return *found;
+    }
+    int before = m_size;
+    Node<Key, Value>* node = place(key);
+    if (m_size != before) node->value = value;
+    if (m_cache) m_cache->put(h, &node->key, &node->value);
+    return node->value;
+}
+
+// Nó de key, criado com valor 1 e rebalanceado se ela ainda não existia.
+// As rotações só religam ponteiros, então o nó devolvido continua válido.
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+Node<Key, Value>* RedBlackTree<Key, Value, OrderStatistics, Stats>::place(const Key& key) {
     Node<Key, Value>* y = m_nil;
     Node<Key, Value>* x = m_root;
 
     while (x != m_nil) {
         y = x;
-        key_comparisons++;
+        m_stats.comparison();
         if (key == x->key) {
-            x->value++;
-            return;
+            return x;
         } else if (key < x->key) {
-            key_comparisons++;
+            m_stats.comparison();
             x = x->left;
         } else {
-            key_comparisons++;
+            m_stats.comparison();
             x = x->right;
         }
     }
 
-    Node<Key, Value>* z = new Node<Key, Value>(key, 1, RED, m_nil, m_nil, m_nil);
+    Node<Key, Value>* z = m_pool.acquire(key, 1, RED, m_nil, m_nil, m_nil);
     z->p = y;
     if (y == m_nil){
         m_root = z;
-        key_comparisons++;
+        m_stats.comparison();
     } else if (z->key < y->key) {
         y->left = z;
     } else {
         y->right = z;
     }
+
+    if constexpr (OrderStatistics) {
+        for (Node<Key, Value>* a = y; a != m_nil; a = a->p) a->size++;
+    }
     
     insertFixup(z);
     m_size++;
+    return z;
 }
 
-template <typename Key, typename Value>
-void RedBlackTree<Key, Value>::update(const Key& key, const Value& new_value) {
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+void RedBlackTree<Key, Value, OrderStatistics, Stats>::update(const Key& key, const Value& new_value) {
     Node<Key, Value>* node = m_root;
     while (node != m_nil) {
-        key_comparisons++;
+        m_stats.comparison();
         if (key == node->key) {
             node->value = new_value;
             return;
@@ -108,13 +257,16 @@ void RedBlackTree<Key, Value>::update(const Key& key, const Value& new_value) {
     throw std::runtime_error("Chave não encontrada para atualização");
 }
 
-template <typename Key, typename Value>
-Value RedBlackTree<Key, Value>::get(const Key& key) const {
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+Value RedBlackTree<Key, Value, OrderStatistics, Stats>::get(const Key& key) const {
+    if (m_cache) {
+        const HotCache<Key, Value>& cache = *m_cache;
+        if (const Value* value = cache.peek(key, cache.hash(key))) return *value;
+    }
     Node<Key, Value>* node = m_root;
     while (node != m_nil) {
-        key_comparisons++;
-        if (key == node->key)
-            return node->value;
+        m_stats.comparison();
+        if (key == node->key) return node->value;
         else if (key < node->key)
             node = node->left;
         else
@@ -123,21 +275,34 @@ Value RedBlackTree<Key, Value>::get(const Key& key) const {
     throw std::runtime_error("Chave não encontrada");
 }
 
-template <typename Key, typename Value>
-void RedBlackTree<Key, Value>::remove(const Key& key) {
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+void RedBlackTree<Key, Value, OrderStatistics, Stats>::remove(const Key& key) {
+    decrement(key);
+}
+
+// Tira uma ocorrência da chave; ao chegar a zero, remove o nó.
+// Devolve true quando a chave saiu do dicionário.
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+bool RedBlackTree<Key, Value, OrderStatistics, Stats>::decrement(const Key& key) {
     Node<Key, Value>* z = m_root;
     while (z != m_nil) {
-        key_comparisons++;
+        m_stats.comparison();
         if (key == z->key) break;
         else if (key < z->key) z = z->left;
         else z = z->right;
     }
 
-    if (z == m_nil) return; // chave não encontrada
+    if (z == m_nil) return false; // chave não encontrada
 
     if (z->value > 1) {
         z->value--; // apenas decrementa a contagem
-        return;
+        return false;
+    }
+
+    if constexpr (OrderStatistics) {
+        // Desconta o nó que sai fisicamente da árvore (z ou seu sucessor)
+        Node<Key, Value>* gone = (z->left == m_nil || z->right == m_nil) ? z : minimum(z->right);
+        for (Node<Key, Value>* a = gone->p; a != m_nil; a = a->p) a->size--;
     }
 
     Node<Key, Value>* y = z;
@@ -165,20 +330,24 @@ void RedBlackTree<Key, Value>::remove(const Key& key) {
         y->left = z->left;
         y->left->p = y;
         y->color = z->color;
+        if constexpr (OrderStatistics) y->size = z->size;
     }
 
-    delete z;
+    if (m_cache) m_cache->invalidate(z->key);
+    m_pool.release(z);
+    m_size--;
 
     if (y_original_color == BLACK) {
         deleteFixup(x);
     }
+    return true;
 }
 
-template <typename Key, typename Value>
-bool RedBlackTree<Key, Value>::contains(const Key& key) const {
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+bool RedBlackTree<Key, Value, OrderStatistics, Stats>::contains(const Key& key) const {
     Node<Key, Value>* node = m_root;
     while (node != m_nil) {
-        key_comparisons++;
+        m_stats.comparison();
         if (key == node->key)
             return true;
         else if (key < node->key)
@@ -189,43 +358,201 @@ bool RedBlackTree<Key, Value>::contains(const Key& key) const {
     return false;
 }
 
-template <typename Key, typename Value>
-void RedBlackTree<Key, Value>::forEach(std::function<void(const Key&, const Value&)> func) const {
-    std::function<void(Node<Key, Value>*)> inOrder = [&](Node<Key, Value>* node) {
-        if (node == m_nil) return;
-        inOrder(node->left);
-        func(node->key, node->value);
-        inOrder(node->right);
-    };
-    inOrder(m_root);
+// Percurso em ordem iterativo pelos ponteiros para o pai: sem pilha nem std::function
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+template <typename F>
+void RedBlackTree<Key, Value, OrderStatistics, Stats>::forEach(F&& func) const {
+    for (const_iterator it = begin(); it != end(); ++it) {
+        func(it->key, it->value);
+    }
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+size_t RedBlackTree<Key, Value, OrderStatistics, Stats>::get_batch(const Key* keys, size_t n, Value* out, const Value& missing) const {
+    return lookup_batch(keys, n, [&](size_t i, const Node<Key, Value>* node) {
+        out[i] = node ? node->value : missing;
+    });
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+size_t RedBlackTree<Key, Value, OrderStatistics, Stats>::contains_batch(const Key* keys, size_t n, bool* out) const {
+    return lookup_batch(keys, n, [&](size_t i, const Node<Key, Value>* node) {
+        out[i] = node != nullptr;
+    });
+}
+
+// Prefetch em grupo: BATCH_GROUP descidas avançam um nível por vez, em
+// sequência, e o filho de cada uma é pedido com prefetch antes de voltar a
+// ela. Assim as faltas de cache das buscas independentes se sobrepõem.
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+template <typename Emit>
+size_t RedBlackTree<Key, Value, OrderStatistics, Stats>::lookup_batch(const Key* keys, size_t n, Emit&& emit) const {
+    Node<Key, Value>* cur[BATCH_GROUP];
+    size_t idx[BATCH_GROUP];
+    size_t found = 0;
+    for (size_t base = 0; base < n; base += BATCH_GROUP) {
+        size_t active = std::min(BATCH_GROUP, n - base);
+        for (size_t j = 0; j < active; j++) {
+            cur[j] = m_root;
+            idx[j] = base + j;
+        }
+        while (active > 0) {
+            for (size_t j = 0; j < active;) {
+                Node<Key, Value>* node = cur[j];
+                const Key& k = keys[idx[j]];
+                Node<Key, Value>* next = m_nil;
+                bool hit = false;
+                bool done = node == m_nil;
+                if (!done) {
+                    m_stats.comparison();
+                    if (k == node->key) {
+                        hit = done = true;
+                    } else {
+                        next = k < node->key ? node->left : node->right;
+                        if (next == m_nil) done = true;
+                    }
+                }
+                if (done) {
+                    if (hit) found++;
+                    emit(idx[j], hit ? node : nullptr);
+                    // Fecha o buraco trazendo a última descida ativa para j
+                    active--;
+                    cur[j] = cur[active];
+                    idx[j] = idx[active];
+                    continue;
+                }
+                __builtin_prefetch(next);
+                cur[j] = next;
+                j++;
+            }
+        }
+    }
+    return found;
 }
 
-template <typename Key, typename Value>
-int RedBlackTree<Key, Value>::size() const {
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+typename RedBlackTree<Key, Value, OrderStatistics, Stats>::const_iterator RedBlackTree<Key, Value, OrderStatistics, Stats>::begin() const {
+    if (m_root == m_nil) return end();
+    return const_iterator(minimum(m_root), this);
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+typename RedBlackTree<Key, Value, OrderStatistics, Stats>::const_iterator RedBlackTree<Key, Value, OrderStatistics, Stats>::end() const {
+    return const_iterator(m_nil, this);
+}
+
+// Primeira chave >= key
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+typename RedBlackTree<Key, Value, OrderStatistics, Stats>::const_iterator RedBlackTree<Key, Value, OrderStatistics, Stats>::lower_bound(const Key& key) const {
+    return bound(key, true);
+}
+
+// Primeira chave > key
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+typename RedBlackTree<Key, Value, OrderStatistics, Stats>::const_iterator RedBlackTree<Key, Value, OrderStatistics, Stats>::upper_bound(const Key& key) const {
+    return bound(key, false);
+}
+
+// Chaves no intervalo fechado [lo, hi]
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+IteratorRange<typename RedBlackTree<Key, Value, OrderStatistics, Stats>::const_iterator> RedBlackTree<Key, Value, OrderStatistics, Stats>::range(const Key& lo, const Key& hi) const {
+    if (hi < lo) return {end(), end()};
+    return {lower_bound(lo), upper_bound(hi)};
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+int RedBlackTree<Key, Value, OrderStatistics, Stats>::rank(const Key& key) const {
+    static_assert(OrderStatistics, "rank exige RedBlackTree com OrderStatistics = true");
+    return count_less(key, false);
+}
+
+// k-ésima menor chave, contando a partir de 0
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+Key RedBlackTree<Key, Value, OrderStatistics, Stats>::select(int k) const {
+    static_assert(OrderStatistics, "select exige RedBlackTree com OrderStatistics = true");
+    if (k < 0 || k >= m_size) throw std::out_of_range("posição inválida");
+    Node<Key, Value>* node = m_root;
+    while (true) {
+        int left = node->left->size;
+        if (k < left) {
+            node = node->left;
+        } else if (k == left) {
+            return node->key;
+        } else {
+            k -= left + 1;
+            node = node->right;
+        }
+    }
+}
+
+// Quantidade de chaves distintas em [lo, hi]
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+int RedBlackTree<Key, Value, OrderStatistics, Stats>::count_range(const Key& lo, const Key& hi) const {
+    static_assert(OrderStatistics, "count_range exige RedBlackTree com OrderStatistics = true");
+    if (hi < lo) return 0;
+    return count_less(hi, true) - count_less(lo, false);
+}
+
+// Chaves < key (ou <= key quando inclusive)
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+int RedBlackTree<Key, Value, OrderStatistics, Stats>::count_less(const Key& key, bool inclusive) const {
+    int count = 0;
+    Node<Key, Value>* node = m_root;
+    while (node != m_nil) {
+        m_stats.comparison();
+        if (inclusive ? key < node->key : !(node->key < key)) {
+            node = node->left;
+        } else {
+            count += node->left->size + 1;
+            node = node->right;
+        }
+    }
+    return count;
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+typename RedBlackTree<Key, Value, OrderStatistics, Stats>::const_iterator RedBlackTree<Key, Value, OrderStatistics, Stats>::bound(const Key& key, bool inclusive) const {
+    Node<Key, Value>* candidate = m_nil;
+    Node<Key, Value>* node = m_root;
+    while (node != m_nil) {
+        m_stats.comparison();
+        if (inclusive ? !(node->key < key) : key < node->key) {
+            candidate = node;
+            node = node->left;
+        } else {
+            node = node->right;
+        }
+    }
+    return const_iterator(candidate, this);
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+int RedBlackTree<Key, Value, OrderStatistics, Stats>::size() const {
     return m_size;
 }
 
-template <typename Key, typename Value>
-void RedBlackTree<Key, Value>::clear() {
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+void RedBlackTree<Key, Value, OrderStatistics, Stats>::clear() {
     std::function<void(Node<Key, Value>*)> destroy = [&](Node<Key, Value>* node) {
         if (node == m_nil) return;
         destroy(node->left);
         destroy(node->right);
-        delete node;
+        m_pool.release(node);
     };
+    if (m_cache) m_cache->clear();
     destroy(m_root);
     m_root = m_nil;
     m_size = 0;
 }
 
-template <typename Key, typename Value>
-void RedBlackTree<Key, Value>::print(std::ostream& out) const {
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+void RedBlackTree<Key, Value, OrderStatistics, Stats>::print(std::ostream& out) const {
     printInOrder(m_root, out);
     std::cout << "\n";
 }
 
-template <typename Key, typename Value>
-Node<Key, Value>* RedBlackTree<Key, Value>::rotateLeft(Node<Key, Value>* x) {
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+Node<Key, Value>* RedBlackTree<Key, Value, OrderStatistics, Stats>::rotateLeft(Node<Key, Value>* x) {
     Node<Key, Value>* y = x->right;
     x->right = y->left;
     if (y->left != m_nil) y->left->p = x;
@@ -237,11 +564,16 @@ Node<Key, Value>* RedBlackTree<Key, Value>::rotateLeft(Node<Key, Value>* x) {
 
     y->left = x;
     x->p = y;
+    m_stats.rotation();
+    if constexpr (OrderStatistics) {
+        y->size = x->size;
+        x->size = x->left->size + x->right->size + 1;
+    }
     return y;
 }
 
-template <typename Key, typename Value>
-Node<Key, Value>* RedBlackTree<Key, Value>::rotateRight(Node<Key, Value>* y) {
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+Node<Key, Value>* RedBlackTree<Key, Value, OrderStatistics, Stats>::rotateRight(Node<Key, Value>* y) {
     Node<Key, Value>* x = y->left;
     y->left = x->right;
     if (x->right != m_nil) x->right->p = y;
@@ -253,52 +585,57 @@ Node<Key, Value>* RedBlackTree<Key, Value>::rotateRight(Node<Key, Value>* y) {
 
     x->right = y;
     y->p = x;
+    m_stats.rotation();
+    if constexpr (OrderStatistics) {
+        x->size = y->size;
+        y->size = y->left->size + y->right->size + 1;
+    }
     return x;
 }
 
-template <typename Key, typename Value>
-void RedBlackTree<Key, Value>::insertFixup(Node<Key, Value>* z) {
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+void RedBlackTree<Key, Value, OrderStatistics, Stats>::insertFixup(Node<Key, Value>* z) {
     while (z->p->color == RED) {
         Node<Key, Value>* gp = z->p->p;
         if (z->p == gp->left) {
             Node<Key, Value>* y = gp->right;
             if (y->color == RED) {
-                z->p->color = BLACK;
-                y->color = BLACK;
-                gp->color = RED;
+                recolor(z->p, BLACK);
+                recolor(y, BLACK);
+                recolor(gp, RED);
                 z = gp;
             } else {
                 if (z == z->p->right) {
                     z = z->p;
                     rotateLeft(z);
                 }
-                z->p->color = BLACK;
-                gp->color = RED;
+                recolor(z->p, BLACK);
+                recolor(gp, RED);
                 rotateRight(gp);
             }
         } else {
             Node<Key, Value>* y = gp->left;
             if (y->color == RED) {
-                z->p->color = BLACK;
-                y->color = BLACK;
-                gp->color = RED;
+                recolor(z->p, BLACK);
+                recolor(y, BLACK);
+                recolor(gp, RED);
                 z = gp;
             } else {
                 if (z == z->p->left) {
                     z = z->p;
                     rotateRight(z);
                 }
-                z->p->color = BLACK;
-                gp->color = RED;
+                recolor(z->p, BLACK);
+                recolor(gp, RED);
                 rotateLeft(gp);
             }
         }
     }
-    m_root->color = BLACK;
+    recolor(m_root, BLACK);
 }
 
-template <typename Key, typename Value>
-void RedBlackTree<Key, Value>::printInOrder(Node<Key, Value>* node, std::ostream& out) const {
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+void RedBlackTree<Key, Value, OrderStatistics, Stats>::printInOrder(Node<Key, Value>* node, std::ostream& out) const {
     if (node == m_nil) return;
 
     printInOrder(node->left, out);
@@ -308,8 +645,8 @@ void RedBlackTree<Key, Value>::printInOrder(Node<Key, Value>* node, std::ostream
     printInOrder(node->right, out);
 }
 
-template <typename Key, typename Value>
-void RedBlackTree<Key, Value>::transplant(Node<Key, Value>* u, Node<Key, Value>* v) {
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+void RedBlackTree<Key, Value, OrderStatistics, Stats>::transplant(Node<Key, Value>* u, Node<Key, Value>* v) {
     if (u->p == m_nil) {
         m_root = v;
     } else if (u == u->p->left) {
@@ -320,72 +657,103 @@ void RedBlackTree<Key, Value>::transplant(Node<Key, Value>* u, Node<Key, Value>*
     v->p = u->p;
 }
 
-template <typename Key, typename Value>
-Node<Key, Value>* RedBlackTree<Key, Value>::minimum(Node<Key, Value>* node) const {
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+Node<Key, Value>* RedBlackTree<Key, Value, OrderStatistics, Stats>::minimum(Node<Key, Value>* node) const {
     while (node->left != m_nil) {
         node = node->left;
     }
     return node;
 }
 
-template <typename Key, typename Value>
-void RedBlackTree<Key, Value>::deleteFixup(Node<Key, Value>* x) {
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+Node<Key, Value>* RedBlackTree<Key, Value, OrderStatistics, Stats>::maximum(Node<Key, Value>* node) const {
+    while (node->right != m_nil) {
+        node = node->right;
+    }
+    return node;
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+void RedBlackTree<Key, Value, OrderStatistics, Stats>::deleteFixup(Node<Key, Value>* x) {
     while (x != m_root && x->color == BLACK) {
         if (x == x->p->left) {
             Node<Key, Value>* w = x->p->right;
             if (w->color == RED) {
-                w->color = BLACK;
-                x->p->color = RED;
+                recolor(w, BLACK);
+                recolor(x->p, RED);
                 rotateLeft(x->p);
                 w = x->p->right;
             }
             if (w->left->color == BLACK && w->right->color == BLACK) {
-                w->color = RED;
+                recolor(w, RED);
                 x = x->p;
             } else {
                 if (w->right->color == BLACK) {
-                    w->left->color = BLACK;
-                    w->color = RED;
+                    recolor(w->left, BLACK);
+                    recolor(w, RED);
                     rotateRight(w);
                     w = x->p->right;
                 }
-                w->color = x->p->color;
-                x->p->color = BLACK;
-                w->right->color = BLACK;
+                recolor(w, x->p->color);
+                recolor(x->p, BLACK);
+                recolor(w->right, BLACK);
                 rotateLeft(x->p);
                 x = m_root;
             }
         } else {
             Node<Key, Value>* w = x->p->left;
             if (w->color == RED) {
-                w->color = BLACK;
-                x->p->color = RED;
+                recolor(w, BLACK);
+                recolor(x->p, RED);
                 rotateRight(x->p);
                 w = x->p->left;
             }
             if (w->right->color == BLACK && w->left->color == BLACK) {
-                w->color = RED;
+                recolor(w, RED);
                 x = x->p;
             } else {
                 if (w->left->color == BLACK) {
-                    w->right->color = BLACK;
-                    w->color = RED;
+                    recolor(w->right, BLACK);
+                    recolor(w, RED);
                     rotateLeft(w);
                     w = x->p->left;
                 }
-                w->color = x->p->color;
-                x->p->color = BLACK;
-                w->left->color = BLACK;
+                recolor(w, x->p->color);
+                recolor(x->p, BLACK);
+                recolor(w->left, BLACK);
                 rotateRight(x->p);
                 x = m_root;
             }
         }
     }
-    x->color = BLACK;
+    recolor(x, BLACK);
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+size_t RedBlackTree<Key, Value, OrderStatistics, Stats>::get_comparisons() const{
+    return m_stats.report().comparisons;
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+void RedBlackTree<Key, Value, OrderStatistics, Stats>::set_hot_cache(size_t sets) {
+    m_cache.reset(sets > 0 ? new HotCache<Key, Value>(sets) : nullptr);
+}
+
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+HotCacheStats RedBlackTree<Key, Value, OrderStatistics, Stats>::hot_cache_stats() const {
+    return m_cache ? m_cache->stats() : HotCacheStats();
+}
+
+// Contadores da política Stats (todos zero com NoStats)
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+StatsReport RedBlackTree<Key, Value, OrderStatistics, Stats>::stats() const{
+    return m_stats.report();
 }
 
-template <typename Key, typename Value>
-size_t RedBlackTree<Key, Value>::get_comparisons() const{
-    return key_comparisons;
+// Troca de cor feita pelo rebalanceamento; só conta quando a cor muda
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+void RedBlackTree<Key, Value, OrderStatistics, Stats>::recolor(Node<Key, Value>* node, bool color) {
+    if (node->color != color) m_stats.recoloring();
+    node->color = color;
 }
 #endif // RED_BLACK_TREE_HPP
\ No newline at end of file
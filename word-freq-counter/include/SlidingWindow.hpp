@@ -0,0 +1,102 @@
+#ifndef SLIDING_WINDOW_HPP
+#define SLIDING_WINDOW_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Janela deslizante sobre um fluxo de palavras: cada palavra que chega
+// incrementa a sua chave no dicionário e, enquanto a janela passar do limite
+// de palavras ou de bytes, a mais antiga sai e tem a contagem decrementada
+// (a chave some ao chegar a zero). O dicionário precisa de insert e
+// decrement; as palavras ficam num anel de strings cujas capacidades são
+// reaproveitadas, então o regime estável não aloca.
+// O anel guarda cópias e não ponteiros para os nós: os dicionários não
+// expõem nós e, na AVL, a remoção copia a chave do sucessor para o nó
+// removido, o que deixaria um ponteiro guardado apontando para outra
+// chave. O preço é uma busca a mais (a do decrement) por palavra expirada.
+template <typename Dict>
+class SlidingWindow {
+public:
+    // Limite 0 significa sem limite naquela medida
+    SlidingWindow(Dict& dict, size_t max_words, size_t max_bytes = 0);
+
+    void push(const std::string& word);
+
+    size_t words() const;      // palavras dentro da janela
+    size_t bytes() const;      // soma dos tamanhos delas
+    size_t evictions() const;  // chaves que saíram do dicionário
+
+private:
+    Dict& m_dict;
+    size_t m_max_words;
+    size_t m_max_bytes;
+    std::vector<std::string> m_ring;
+    size_t m_head;      // posição da palavra mais antiga
+    size_t m_count;
+    size_t m_bytes;
+    size_t m_evictions;
+
+    void expire();
+    void grow();
+};
+
+template <typename Dict>
+SlidingWindow<Dict>::SlidingWindow(Dict& dict, size_t max_words, size_t max_bytes)
+    : m_dict(dict), m_max_words(max_words), m_max_bytes(max_bytes),
+      m_head(0), m_count(0), m_bytes(0), m_evictions(0) {
+    // Com limite de palavras, a que chega entra antes de a mais antiga sair
+    m_ring.resize(max_words > 0 ? max_words + 1 : 64);
+}
+
+template <typename Dict>
+void SlidingWindow<Dict>::push(const std::string& word) {
+    // Só com limite de bytes o número de palavras não é conhecido de antemão
+    if (m_count == m_ring.size()) grow();
+    m_ring[(m_head + m_count) % m_ring.size()] = word;
+    m_count++;
+    m_bytes += word.size();
+    m_dict.insert(word);
+    expire();
+}
+
+// Retira as palavras mais antigas até a janela voltar aos limites
+template <typename Dict>
+void SlidingWindow<Dict>::expire() {
+    while ((m_max_words > 0 && m_count > m_max_words) ||
+           (m_max_bytes > 0 && m_bytes > m_max_bytes && m_count > 1)) {
+        const std::string& oldest = m_ring[m_head];
+        if (m_dict.decrement(oldest)) m_evictions++;
+        m_bytes -= oldest.size();
+        m_head = (m_head + 1) % m_ring.size();
+        m_count--;
+    }
+}
+
+// Dobra o anel mantendo a ordem, com a mais antiga na posição 0
+template <typename Dict>
+void SlidingWindow<Dict>::grow() {
+    std::vector<std::string> bigger(m_ring.size() * 2);
+    for (size_t i = 0; i < m_count; i++) {
+        bigger[i].swap(m_ring[(m_head + i) % m_ring.size()]);
+    }
+    m_ring.swap(bigger);
+    m_head = 0;
+}
+
+template <typename Dict>
+size_t SlidingWindow<Dict>::words() const {
+    return m_count;
+}
+
+template <typename Dict>
+size_t SlidingWindow<Dict>::bytes() const {
+    return m_bytes;
+}
+
+template <typename Dict>
+size_t SlidingWindow<Dict>::evictions() const {
+    return m_evictions;
+}
+
+#endif
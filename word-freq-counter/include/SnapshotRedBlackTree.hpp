@@ -0,0 +1,443 @@
+#ifndef SNAPSHOT_RED_BLACK_TREE_HPP
+#define SNAPSHOT_RED_BLACK_TREE_HPP
+
+#include <iostream>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "EpochReclamation.hpp"
+
+// Árvore rubro-negra para um escritor e vários leitores simultâneos.
+// As escritas copiam o caminho da raiz até o nó alterado (a árvore
+// publicada nunca é modificada) e a nova raiz é publicada atomicamente,
+// no estilo RCU. Um leitor fixa uma versão com snapshot() e lê sem trava
+// uma árvore consistente; os nós substituídos são entregues ao
+// EpochManager e liberados quando nenhum leitor pode mais alcançá-los.
+//
+// Sem ponteiro para o pai, o balanceamento segue a variante
+// left-leaning (Sedgewick), cujas inserções e remoções são recursivas de
+// cima para baixo e combinam naturalmente com a cópia de caminho.
+// Nós criados desde a última publicação pertencem só ao escritor e são
+// alterados no lugar; com set_publish_interval(n) o escritor publica a
+// cada n escritas e copia cada nó no máximo uma vez por publicação.
+template <typename Key, typename Value>
+class SnapshotRedBlackTree {
+private:
+    struct TreeNode {
+        Key key;
+        Value value;
+        TreeNode* left;
+        TreeNode* right;
+        int size;                   // tamanho da subárvore
+        bool color;
+        uint64_t version;           // publicação em que o nó foi criado
+        TreeNode* retired_next;     // usado pelo EpochManager
+
+        TreeNode(const Key& k, const Value& v, uint64_t ver)
+            : key(k), value(v), left(nullptr), right(nullptr), size(1), color(RED), version(ver), retired_next(nullptr) {}
+    };
+
+    static constexpr bool RED = 0;
+    static constexpr bool BLACK = 1;
+
+    using Epochs = EpochManager<TreeNode>;
+
+public:
+    // Versão imutável da árvore; mantém a época fixa enquanto existir
+    class Snapshot {
+    public:
+        Value get(const Key& key) const;
+        bool contains(const Key& key) const;
+        template <typename F>
+        void forEach(F&& func) const;
+        int size() const;
+        void print(std::ostream& out = std::cout) const;
+
+    private:
+        friend class SnapshotRedBlackTree;
+        explicit Snapshot(const SnapshotRedBlackTree& tree);
+
+        typename Epochs::Guard m_guard;
+        const TreeNode* m_root;
+    };
+
+    SnapshotRedBlackTree();
+    ~SnapshotRedBlackTree();
+
+    SnapshotRedBlackTree(const SnapshotRedBlackTree&) = delete;
+    SnapshotRedBlackTree& operator=(const SnapshotRedBlackTree&) = delete;
+
+    // Escrita: apenas uma thread
+    void insert(const Key& key);
+    void add(const Key& key, const Value& value);
+    void update(const Key& key, const Value& new_value);
+    void remove(const Key& key);
+    void publish();
+    void set_publish_interval(int writes);
+
+    // Leitura: qualquer thread, sempre sobre a última versão publicada
+    Snapshot snapshot() const;
+    Value get(const Key& key) const;
+    bool contains(const Key& key) const;
+    template <typename F>
+    void forEach(F&& func) const;
+    int size() const;
+    void print(std::ostream& out = std::cout) const;
+
+private:
+    std::atomic<TreeNode*> m_root;      // versão publicada
+    TreeNode* m_draft;                  // versão do escritor
+    uint64_t m_version;                 // versão dos nós ainda não publicados
+    std::vector<TreeNode*> m_replaced;  // nós publicados que já foram copiados
+    int m_publish_interval;
+    int m_pending;
+    mutable Epochs m_epochs;
+
+    static void destroy_node(TreeNode* node);
+    static void destroy_tree(TreeNode* node);
+    static bool isRed(const TreeNode* node);
+    static int sizeOf(const TreeNode* node);
+    static const TreeNode* find(const TreeNode* node, const Key& key);
+    template <typename F>
+    static void inOrder(const TreeNode* node, F& func);
+
+    TreeNode* own(TreeNode* node);
+    void dispose(TreeNode* node);
+    void wrote();
+
+    TreeNode* insert(TreeNode* h, const Key& key, const Value& value, bool accumulate);
+    TreeNode* remove(TreeNode* h, const Key& key);
+    TreeNode* removeMin(TreeNode* h, TreeNode* target);
+    TreeNode* rotateLeft(TreeNode* h);
+    TreeNode* rotateRight(TreeNode* h);
+    void flipColors(TreeNode* h);
+    TreeNode* moveRedLeft(TreeNode* h);
+    TreeNode* moveRedRight(TreeNode* h);
+    TreeNode* balance(TreeNode* h);
+};
+
+template <typename Key, typename Value>
+SnapshotRedBlackTree<Key, Value>::Snapshot::Snapshot(const SnapshotRedBlackTree& tree) : m_guard(tree.m_epochs) {
+    m_root = tree.m_root.load(std::memory_order_acquire);
+}
+
+template <typename Key, typename Value>
+Value SnapshotRedBlackTree<Key, Value>::Snapshot::get(const Key& key) const {
+    const TreeNode* node = find(m_root, key);
+    if (!node) throw std::runtime_error("Chave não encontrada");
+    return node->value;
+}
+
+template <typename Key, typename Value>
+bool SnapshotRedBlackTree<Key, Value>::Snapshot::contains(const Key& key) const {
+    return find(m_root, key) != nullptr;
+}
+
+template <typename Key, typename Value>
+template <typename F>
+void SnapshotRedBlackTree<Key, Value>::Snapshot::forEach(F&& func) const {
+    inOrder(m_root, func);
+}
+
+template <typename Key, typename Value>
+int SnapshotRedBlackTree<Key, Value>::Snapshot::size() const {
+    return sizeOf(m_root);
+}
+
+template <typename Key, typename Value>
+void SnapshotRedBlackTree<Key, Value>::Snapshot::print(std::ostream& out) const {
+    forEach([&](const Key& k, const Value& v) {
+        out << k << " : " << v << '\n';
+    });
+}
+
+template <typename Key, typename Value>
+SnapshotRedBlackTree<Key, Value>::SnapshotRedBlackTree() : m_epochs(&SnapshotRedBlackTree::destroy_node) {
+    m_root.store(nullptr);
+    m_draft = nullptr;
+    m_version = 1;
+    m_publish_interval = 1;
+    m_pending = 0;
+}
+
+// Nós da versão do escritor e os já copiados ainda não foram às épocas;
+// o restante (versões antigas) o EpochManager libera ao ser destruído
+template <typename Key, typename Value>
+SnapshotRedBlackTree<Key, Value>::~SnapshotRedBlackTree() {
+    destroy_tree(m_draft);
+    for (TreeNode* node : m_replaced) destroy_node(node);
+}
+
+template <typename Key, typename Value>
+void SnapshotRedBlackTree<Key, Value>::destroy_node(TreeNode* node) {
+    delete node;
+}
+
+template <typename Key, typename Value>
+void SnapshotRedBlackTree<Key, Value>::destroy_tree(TreeNode* node) {
+    while (node) {
+        destroy_tree(node->left);
+        TreeNode* right = node->right;
+        delete node;
+        node = right;
+    }
+}
+
+template <typename Key, typename Value>
+bool SnapshotRedBlackTree<Key, Value>::isRed(const TreeNode* node) {
+    return node && node->color == RED;
+}
+
+template <typename Key, typename Value>
+int SnapshotRedBlackTree<Key, Value>::sizeOf(const TreeNode* node) {
+    return node ? node->size : 0;
+}
+
+template <typename Key, typename Value>
+const typename SnapshotRedBlackTree<Key, Value>::TreeNode*
+SnapshotRedBlackTree<Key, Value>::find(const TreeNode* node, const Key& key) {
+    while (node) {
+        if (key < node->key) node = node->left;
+        else if (node->key < key) node = node->right;
+        else return node;
+    }
+    return nullptr;
+}
+
+template <typename Key, typename Value>
+template <typename F>
+void SnapshotRedBlackTree<Key, Value>::inOrder(const TreeNode* node, F& func) {
+    std::vector<const TreeNode*> stack;
+    while (node || !stack.empty()) {
+        while (node) {
+            stack.push_back(node);
+            node = node->left;
+        }
+        node = stack.back();
+        stack.pop_back();
+        func(node->key, node->value);
+        node = node->right;
+    }
+}
+
+// Devolve uma cópia do nó que o escritor pode alterar. Nós já publicados
+// são copiados uma vez por versão; o original vai para m_replaced.
+template <typename Key, typename Value>
+typename SnapshotRedBlackTree<Key, Value>::TreeNode*
+SnapshotRedBlackTree<Key, Value>::own(TreeNode* node) {
+    if (node->version == m_version) return node;
+    TreeNode* copy = new TreeNode(*node);
+    copy->version = m_version;
+    m_replaced.push_back(node);
+    return copy;
+}
+
+// Nó que saiu da árvore do escritor
+template <typename Key, typename Value>
+void SnapshotRedBlackTree<Key, Value>::dispose(TreeNode* node) {
+    if (node->version == m_version) delete node;
+    else m_replaced.push_back(node);
+}
+
+template <typename Key, typename Value>
+void SnapshotRedBlackTree<Key, Value>::wrote() {
+    if (++m_pending >= m_publish_interval) publish();
+}
+
+// Publica a versão do escritor; só depois disso os nós substituídos ficam
+// fora do alcance de novos leitores e podem ser retirados
+template <typename Key, typename Value>
+void SnapshotRedBlackTree<Key, Value>::publish() {
+    m_root.store(m_draft, std::memory_order_release);
+    m_version++;
+    m_pending = 0;
+    if (m_replaced.empty()) return;
+    typename Epochs::Guard guard(m_epochs);
+    for (TreeNode* node : m_replaced) m_epochs.retire(node);
+    m_replaced.clear();
+}
+
+template <typename Key, typename Value>
+void SnapshotRedBlackTree<Key, Value>::set_publish_interval(int writes) {
+    m_publish_interval = writes > 0 ? writes : 1;
+    if (m_pending >= m_publish_interval) publish();
+}
+
+template <typename Key, typename Value>
+void SnapshotRedBlackTree<Key, Value>::insert(const Key& key) {
+    m_draft = insert(m_draft, key, Value(1), true);
+    m_draft->color = BLACK;
+    wrote();
+}
+
+template <typename Key, typename Value>
+void SnapshotRedBlackTree<Key, Value>::add(const Key& key, const Value& value) {
+    m_draft = insert(m_draft, key, value, false);
+    m_draft->color = BLACK;
+    wrote();
+}
+
+template <typename Key, typename Value>
+void SnapshotRedBlackTree<Key, Value>::update(const Key& key, const Value& new_value) {
+    if (!find(m_draft, key)) throw std::runtime_error("Chave não encontrada");
+    add(key, new_value);
+}
+
+template <typename Key, typename Value>
+void SnapshotRedBlackTree<Key, Value>::remove(const Key& key) {
+    if (!find(m_draft, key)) return;
+    m_draft = own(m_draft);
+    if (!isRed(m_draft->left) && !isRed(m_draft->right)) m_draft->color = RED;
+    m_draft = remove(m_draft, key);
+    if (m_draft) m_draft->color = BLACK;
+    wrote();
+}
+
+template <typename Key, typename Value>
+typename SnapshotRedBlackTree<Key, Value>::Snapshot SnapshotRedBlackTree<Key, Value>::snapshot() const {
+    return Snapshot(*this);
+}
+
+template <typename Key, typename Value>
+Value SnapshotRedBlackTree<Key, Value>::get(const Key& key) const {
+    return snapshot().get(key);
+}
+
+template <typename Key, typename Value>
+bool SnapshotRedBlackTree<Key, Value>::contains(const Key& key) const {
+    return snapshot().contains(key);
+}
+
+template <typename Key, typename Value>
+template <typename F>
+void SnapshotRedBlackTree<Key, Value>::forEach(F&& func) const {
+    snapshot().forEach(func);
+}
+
+template <typename Key, typename Value>
+int SnapshotRedBlackTree<Key, Value>::size() const {
+    return snapshot().size();
+}
+
+template <typename Key, typename Value>
+void SnapshotRedBlackTree<Key, Value>::print(std::ostream& out) const {
+    snapshot().print(out);
+}
+
+template <typename Key, typename Value>
+typename SnapshotRedBlackTree<Key, Value>::TreeNode*
+SnapshotRedBlackTree<Key, Value>::insert(TreeNode* h, const Key& key, const Value& value, bool accumulate) {
+    if (!h) return new TreeNode(key, value, m_version);
+    h = own(h);
+    if (key < h->key) h->left = insert(h->left, key, value, accumulate);
+    else if (h->key < key) h->right = insert(h->right, key, value, accumulate);
+    else h->value = accumulate ? h->value + value : value;
+    return balance(h);
+}
+
+// h já pertence ao escritor e contém a chave em alguma subárvore
+template <typename Key, typename Value>
+typename SnapshotRedBlackTree<Key, Value>::TreeNode*
+SnapshotRedBlackTree<Key, Value>::remove(TreeNode* h, const Key& key) {
+    if (key < h->key) {
+        if (!isRed(h->left) && !isRed(h->left->left)) h = moveRedLeft(h);
+        h->left = remove(own(h->left), key);
+    } else {
+        if (isRed(h->left)) h = rotateRight(h);
+        if (!(h->key < key) && !h->right) {
+            dispose(h);
+            return nullptr;
+        }
+        if (!isRed(h->right) && !isRed(h->right->left)) h = moveRedRight(h);
+        if (!(h->key < key)) h->right = removeMin(own(h->right), h);
+        else h->right = remove(own(h->right), key);
+    }
+    return balance(h);
+}
+
+// Remove o mínimo de h e copia sua chave e valor para target
+template <typename Key, typename Value>
+typename SnapshotRedBlackTree<Key, Value>::TreeNode*
+SnapshotRedBlackTree<Key, Value>::removeMin(TreeNode* h, TreeNode* target) {
+    if (!h->left) {
+        target->key = h->key;
+        target->value = h->value;
+        dispose(h);
+        return nullptr;
+    }
+    if (!isRed(h->left) && !isRed(h->left->left)) h = moveRedLeft(h);
+    h->left = removeMin(own(h->left), target);
+    return balance(h);
+}
+
+template <typename Key, typename Value>
+typename SnapshotRedBlackTree<Key, Value>::TreeNode*
+SnapshotRedBlackTree<Key, Value>::rotateLeft(TreeNode* h) {
+    TreeNode* x = own(h->right);
+    h->right = x->left;
+    x->left = h;
+    x->color = h->color;
+    h->color = RED;
+    x->size = h->size;
+    h->size = 1 + sizeOf(h->left) + sizeOf(h->right);
+    return x;
+}
+
+template <typename Key, typename Value>
+typename SnapshotRedBlackTree<Key, Value>::TreeNode*
+SnapshotRedBlackTree<Key, Value>::rotateRight(TreeNode* h) {
+    TreeNode* x = own(h->left);
+    h->left = x->right;
+    x->right = h;
+    x->color = h->color;
+    h->color = RED;
+    x->size = h->size;
+    h->size = 1 + sizeOf(h->left) + sizeOf(h->right);
+    return x;
+}
+
+template <typename Key, typename Value>
+void SnapshotRedBlackTree<Key, Value>::flipColors(TreeNode* h) {
+    h->color = !h->color;
+    h->left = own(h->left);
+    h->left->color = !h->left->color;
+    h->right = own(h->right);
+    h->right->color = !h->right->color;
+}
+
+template <typename Key, typename Value>
+typename SnapshotRedBlackTree<Key, Value>::TreeNode*
+SnapshotRedBlackTree<Key, Value>::moveRedLeft(TreeNode* h) {
+    flipColors(h);
+    if (isRed(h->right->left)) {
+        h->right = rotateRight(h->right);
+        h = rotateLeft(h);
+        flipColors(h);
+    }
+    return h;
+}
+
+template <typename Key, typename Value>
+typename SnapshotRedBlackTree<Key, Value>::TreeNode*
+SnapshotRedBlackTree<Key, Value>::moveRedRight(TreeNode* h) {
+    flipColors(h);
+    if (isRed(h->left->left)) {
+        h = rotateRight(h);
+        flipColors(h);
+    }
+    return h;
+}
+
+template <typename Key, typename Value>
+typename SnapshotRedBlackTree<Key, Value>::TreeNode*
+SnapshotRedBlackTree<Key, Value>::balance(TreeNode* h) {
+    if (isRed(h->right) && !isRed(h->left)) h = rotateLeft(h);
+    if (isRed(h->left) && isRed(h->left->left)) h = rotateRight(h);
+    if (isRed(h->left) && isRed(h->right)) flipColors(h);
+    h->size = 1 + sizeOf(h->left) + sizeOf(h->right);
+    return h;
+}
+
+#endif // SNAPSHOT_RED_BLACK_TREE_HPP
@@ -0,0 +1,56 @@
+#ifndef SPILL_MERGE_HPP
+#define SPILL_MERGE_HPP
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Volume e tempo da contagem em memória externa
+struct SpillStats {
+    size_t runs = 0;            // runs gravadas pela contagem
+    size_t passes = 0;          // passadas de fusão intermediárias
+    uint64_t bytes_written = 0;
+    uint64_t bytes_read = 0;
+    double spill_ms = 0;
+    double merge_ms = 0;
+};
+
+// Runs ordenadas num diretório temporário próprio, apagado no destrutor.
+// Cada run é uma sequência de (chave, contagem) em ordem crescente de
+// chave, com tamanhos e contagens em varint. A fusão final lê todas as runs
+// em paralelo e soma as contagens de chaves iguais.
+class SpillSet {
+public:
+    // Cria o diretório dentro de temp_dir (ou do diretório temporário do sistema)
+    explicit SpillSet(const std::string& temp_dir = "");
+    ~SpillSet();
+
+    SpillSet(const SpillSet&) = delete;
+    SpillSet& operator=(const SpillSet&) = delete;
+
+    // Ordena as entradas pela chave e as grava como uma nova run
+    void spill(std::vector<std::pair<const std::string*, int>>& entries);
+
+    // Funde as runs em ordem de chave, entregando cada chave uma vez com a
+    // contagem total. Com mais runs que MERGE_FAN_IN, funde grupos antes.
+    void merge(const std::function<void(const std::string&, int64_t)>& func);
+
+    size_t runs() const;
+    const SpillStats& stats() const;
+
+    static const size_t MERGE_FAN_IN = 64;
+
+private:
+    std::string m_dir;
+    std::vector<std::string> m_runs;
+    size_t m_next_id;
+    SpillStats m_stats;
+
+    std::string newRunPath();
+    void mergeRuns(const std::vector<std::string>& runs,
+                   const std::function<void(const std::string&, int64_t)>& func);
+};
+
+#endif
@@ -0,0 +1,416 @@
+#ifndef SPLAY_TREE_HPP
+#define SPLAY_TREE_HPP
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Node.hpp"
+#include "Stats.hpp"
+#include "NodePool.hpp"
+
+// Árvore splay: todo acesso (inclusive get e contains) traz a chave para a
+// raiz, então as palavras frequentes ficam perto do topo sem nenhum
+// critério de balanceamento. Com SemiSplay = true, cada acesso só encurta
+// pela metade o caminho até a chave (semi-splay de Sleator e Tarjan), o que
+// faz menos rotações por acesso ao custo de adaptar mais devagar.
+template <typename Key, typename Value, bool SemiSplay = false, typename Stats = NoStats>
+class SplayTree {
+public:
+    SplayTree();
+    ~SplayTree();
+
+    void insert(const Key& k);
+    // Valor de k, inserindo-o com value se ausente, num só acesso
+    Value insert_or_get(const Key& k, const Value& value);
+    void update(const Key& key, const Value& new_value);
+    Value get(const Key& key) const;
+    void remove(const Key& k);
+    bool decrement(const Key& k);
+    bool contains(const Key& k) const;
+    template <typename F>
+    void forEach(F&& func) const;
+    int size() const;
+    void clear();
+    void print(std::ostream& out = std::cout) const;
+
+    int height() const;
+    size_t get_comparisons() const;
+    StatsReport stats() const;
+
+private:
+    // Acessos reestruturam a árvore, por isso a raiz é mutable e as
+    // consultas continuam const para quem usa o dicionário
+    mutable Node<Key, Value>* m_root;
+    int m_size;
+
+    mutable Stats m_stats;
+    mutable std::vector<Node<Key, Value>*> m_path;  // caminho do semi-splay
+    NodePool<Node<Key, Value>> m_pool;
+
+    Node<Key, Value>* access(const Key& k) const;
+    Node<Key, Value>* place(const Key& k);
+    Node<Key, Value>* splay(Node<Key, Value>* t, const Key& k) const;
+    void semi_splay() const;
+    void erase(const Key& k);
+};
+
+template <typename Key, typename Value, bool SemiSplay, typename Stats>
+SplayTree<Key, Value, SemiSplay, Stats>::SplayTree() {
+    m_root = nullptr;
+    m_size = 0;
+    m_stats.log("dicionário construído com valores padrão");
+}
+
+template <typename Key, typename Value, bool SemiSplay, typename Stats>
+SplayTree<Key, Value, SemiSplay, Stats>::~SplayTree() {
+    clear();
+}
+
+template <typename Key, typename Value, bool SemiSplay, typename Stats>
+void SplayTree<Key, Value, SemiSplay, Stats>::insert(const Key& k) {
+    int before = m_size;
+    Node<Key, Value>* node = place(k);
+    if (m_size == before) node->value++;
+}
+
+template <typename Key, typename Value, bool SemiSplay, typename Stats>
+Value SplayTree<Key, Value, SemiSplay, Stats>::insert_or_get(const Key& k, const Value& value) {
+    int before = m_size;
+    Node<Key, Value>* node = place(k);
+    if (m_size != before) node->value = value;
+    return node->value;
+}
+
+// Nó de k, criado com valor 1 se ela ainda não existia, depois do splay
+// (ou semi-splay) que o acesso faz de qualquer forma
+template <typename Key, typename Value, bool SemiSplay, typename Stats>
+Node<Key, Value>* SplayTree<Key, Value, SemiSplay, Stats>::place(const Key& k) {
+    if (SemiSplay) {
+        m_path.clear();
+        Node<Key, Value>** link = &m_root;
+        while (*link != nullptr) {
+            Node<Key, Value>* t = *link;
+            m_path.push_back(t);
+            m_stats.comparison();
+            if (k == t->key) {
+                semi_splay();
+                return t;
+            }
+            link = k < t->key ? &t->left : &t->right;
+        }
+        Node<Key, Value>* node = m_pool.acquire(k, 1);
+        *link = node;
+        m_path.push_back(node);
+        m_size++;
+        semi_splay();
+        return node;
+    }
+
+    if (m_root == nullptr) {
+        m_root = m_pool.acquire(k, 1);
+        m_size++;
+        return m_root;
+    }
+    m_root = splay(m_root, k);
+    if (k == m_root->key) return m_root;
+    // A raiz depois do splay é vizinha de k: o novo nó a divide em duas
+    Node<Key, Value>* node = m_pool.acquire(k, 1);
+    if (k < m_root->key) {
+        node->left = m_root->left;
+        node->right = m_root;
+        m_root->left = nullptr;
+    } else {
+        node->right = m_root->right;
+        node->left = m_root;
+        m_root->right = nullptr;
+    }
+    m_root = node;
+    m_size++;
+    return node;
+}
+
+template <typename Key, typename Value, bool SemiSplay, typename Stats>
+void SplayTree<Key, Value, SemiSplay, Stats>::update(const Key& key, const Value& new_value) {
+    Node<Key, Value>* node = access(key);
+    if (node == nullptr) throw std::runtime_error("Chave não encontrada para atualização");
+    node->value = new_value;
+}
+
+template <typename Key, typename Value, bool SemiSplay, typename Stats>
+Value SplayTree<Key, Value, SemiSplay, Stats>::get(const Key& key) const {
+    Node<Key, Value>* node = access(key);
+    if (node == nullptr) throw std::runtime_error("Chave não encontrada");
+    return node->value;
+}
+
+template <typename Key, typename Value, bool SemiSplay, typename Stats>
+void SplayTree<Key, Value, SemiSplay, Stats>::remove(const Key& k) {
+    if (access(k) == nullptr) return;
+    erase(k);
+    m_stats.log("chave ", k, " removida");
+}
+
+// Tira uma ocorrência da chave; ao chegar a zero, remove o nó.
+// Devolve true quando a chave saiu do dicionário.
+template <typename Key, typename Value, bool SemiSplay, typename Stats>
+bool SplayTree<Key, Value, SemiSplay, Stats>::decrement(const Key& k) {
+    Node<Key, Value>* node = access(k);
+    if (node == nullptr) return false;
+    if (node->value > 1) {
+        node->value--;
+        return false;
+    }
+    erase(k);
+    return true;
+}
+
+template <typename Key, typename Value, bool SemiSplay, typename Stats>
+bool SplayTree<Key, Value, SemiSplay, Stats>::contains(const Key& k) const {
+    return access(k) != nullptr;
+}
+
+// Percurso em ordem iterativo: uma árvore splay pode ficar com altura n
+// (por exemplo, depois de inserções em ordem), então nada aqui é recursivo
+template <typename Key, typename Value, bool SemiSplay, typename Stats>
+template <typename F>
+void SplayTree<Key, Value, SemiSplay, Stats>::forEach(F&& func) const {
+    std::vector<Node<Key, Value>*> stack;
+    Node<Key, Value>* node = m_root;
+    while (node != nullptr || !stack.empty()) {
+        while (node != nullptr) {
+            stack.push_back(node);
+            node = node->left;
+        }
+        node = stack.back();
+        stack.pop_back();
+        func(node->key, node->value);
+        node = node->right;
+    }
+}
+
+template <typename Key, typename Value, bool SemiSplay, typename Stats>
+int SplayTree<Key, Value, SemiSplay, Stats>::size() const {
+    return m_size;
+}
+
+// Libera os nós girando à direita até cada raiz não ter filho esquerdo,
+// sem pilha
+template <typename Key, typename Value, bool SemiSplay, typename Stats>
+void SplayTree<Key, Value, SemiSplay, Stats>::clear() {
+    Node<Key, Value>* node = m_root;
+    while (node != nullptr) {
+        if (node->left != nullptr) {
+            Node<Key, Value>* l = node->left;
+            node->left = l->right;
+            l->right = node;
+            node = l;
+        } else {
+            Node<Key, Value>* next = node->right;
+            m_pool.release(node);
+            node = next;
+        }
+    }
+    m_root = nullptr;
+    m_size = 0;
+}
+
+template <typename Key, typename Value, bool SemiSplay, typename Stats>
+void SplayTree<Key, Value, SemiSplay, Stats>::print(std::ostream& out) const {
+    forEach([&](const Key& key, const Value& value) {
+        out << key << " : " << value << '\n';
+    });
+}
+
+template <typename Key, typename Value, bool SemiSplay, typename Stats>
+int SplayTree<Key, Value, SemiSplay, Stats>::height() const {
+    int best = 0;
+    std::vector<std::pair<Node<Key, Value>*, int>> stack;
+    if (m_root != nullptr) stack.emplace_back(m_root, 1);
+    while (!stack.empty()) {
+        auto [node, depth] = stack.back();
+        stack.pop_back();
+        best = std::max(best, depth);
+        if (node->left != nullptr) stack.emplace_back(node->left, depth + 1);
+        if (node->right != nullptr) stack.emplace_back(node->right, depth + 1);
+    }
+    return best;
+}
+
+template <typename Key, typename Value, bool SemiSplay, typename Stats>
+size_t SplayTree<Key, Value, SemiSplay, Stats>::get_comparisons() const {
+    return m_stats.report().comparisons;
+}
+
+// Contadores da política Stats (todos zero com NoStats)
+template <typename Key, typename Value, bool SemiSplay, typename Stats>
+StatsReport SplayTree<Key, Value, SemiSplay, Stats>::stats() const {
+    return m_stats.report();
+}
+
+// Procura k reestruturando a árvore; devolve o nó ou nullptr. No splay
+// completo o nó encontrado (ou o último visitado) fica na raiz.
+template <typename Key, typename Value, bool SemiSplay, typename Stats>
+Node<Key, Value>* SplayTree<Key, Value, SemiSplay, Stats>::access(const Key& k) const {
+    if (SemiSplay) {
+        m_path.clear();
+        Node<Key, Value>* t = m_root;
+        Node<Key, Value>* found = nullptr;
+        while (t != nullptr) {
+            m_path.push_back(t);
+            m_stats.comparison();
+            if (k == t->key) {
+                found = t;
+                break;
+            }
+            t = k < t->key ? t->left : t->right;
+        }
+        if (!m_path.empty()) semi_splay();
+        return found;
+    }
+
+    if (m_root == nullptr) return nullptr;
+    m_root = splay(m_root, k);
+    return k == m_root->key ? m_root : nullptr;
+}
+
+// Splay top-down: desce uma vez, pendurando os nós menores que k numa
+// árvore à esquerda e os maiores numa à direita, e no fim remonta tudo em
+// volta do último nó visitado. Cada ligação conta como uma rotação, o que
+// dá o mesmo total do splay de baixo para cima (zig = 1, zig-zig e zig-zag = 2).
+template <typename Key, typename Value, bool SemiSplay, typename Stats>
+Node<Key, Value>* SplayTree<Key, Value, SemiSplay, Stats>::splay(Node<Key, Value>* t, const Key& k) const {
+    Node<Key, Value> header;
+    Node<Key, Value>* l = &header;
+    Node<Key, Value>* r = &header;
+    header.left = header.right = nullptr;
+    while (true) {
+        m_stats.comparison();
+        if (k < t->key) {
+            if (t->left == nullptr) break;
+            m_stats.comparison();
+            if (k < t->left->key) {
+                // zig-zig: gira à direita antes de ligar
+                Node<Key, Value>* y = t->left;
+                t->left = y->right;
+                y->right = t;
+                t = y;
+                m_stats.rotation();
+                if (t->left == nullptr) break;
+            }
+            r->left = t;
+            r = t;
+            m_stats.rotation();
+            t = t->left;
+        } else if (t->key < k) {
+            if (t->right == nullptr) break;
+            m_stats.comparison();
+            if (t->right->key < k) {
+                Node<Key, Value>* y = t->right;
+                t->right = y->left;
+                y->left = t;
+                t = y;
+                m_stats.rotation();
+                if (t->right == nullptr) break;
+            }
+            l->right = t;
+            l = t;
+            m_stats.rotation();
+            t = t->right;
+        } else {
+            break;
+        }
+    }
+    l->right = t->left;
+    r->left = t->right;
+    t->left = header.right;
+    t->right = header.left;
+    return t;
+}
+
+// Semi-splay de baixo para cima sobre o caminho em m_path (raiz primeiro).
+// Em zig-zig só o pai sobe, e o passo seguinte continua dele; em zig-zag o
+// nó sobe dois níveis. O caminho fica com cerca de metade da profundidade.
+template <typename Key, typename Value, bool SemiSplay, typename Stats>
+void SplayTree<Key, Value, SemiSplay, Stats>::semi_splay() const {
+    size_t i = m_path.size() - 1;
+    while (i >= 2) {
+        Node<Key, Value>* x = m_path[i];
+        Node<Key, Value>* y = m_path[i - 1];
+        Node<Key, Value>* z = m_path[i - 2];
+        Node<Key, Value>** link = &m_root;
+        if (i >= 3) link = m_path[i - 3]->left == z ? &m_path[i - 3]->left : &m_path[i - 3]->right;
+        bool xLeft = y->left == x;
+        bool yLeft = z->left == y;
+        if (xLeft == yLeft) {
+            if (yLeft) {
+                z->left = y->right;
+                y->right = z;
+            } else {
+                z->right = y->left;
+                y->left = z;
+            }
+            *link = y;
+            m_path[i - 2] = y;
+            m_stats.rotation();
+        } else {
+            if (xLeft) {
+                y->left = x->right;
+                z->right = x->left;
+                x->right = y;
+                x->left = z;
+            } else {
+                y->right = x->left;
+                z->left = x->right;
+                x->left = y;
+                x->right = z;
+            }
+            *link = x;
+            m_path[i - 2] = x;
+            m_stats.rotation();
+            m_stats.rotation();
+        }
+        i -= 2;
+    }
+    m_path.clear();
+}
+
+// Remove o nó de k, que access acabou de encontrar
+template <typename Key, typename Value, bool SemiSplay, typename Stats>
+void SplayTree<Key, Value, SemiSplay, Stats>::erase(const Key& k) {
+    Node<Key, Value>* z;
+    if (SemiSplay) {
+        // Remoção comum de ABB, trocando pelo sucessor
+        Node<Key, Value>** link = &m_root;
+        while (!(k == (*link)->key)) link = k < (*link)->key ? &(*link)->left : &(*link)->right;
+        z = *link;
+        if (z->left == nullptr) {
+            *link = z->right;
+        } else if (z->right == nullptr) {
+            *link = z->left;
+        } else {
+            Node<Key, Value>** s = &z->right;
+            while ((*s)->left != nullptr) s = &(*s)->left;
+            Node<Key, Value>* succ = *s;
+            *s = succ->right;
+            succ->left = z->left;
+            succ->right = z->right;
+            *link = succ;
+        }
+    } else {
+        // k está na raiz: o maior da subárvore esquerda sobe e herda a direita
+        z = m_root;
+        if (z->left == nullptr) {
+            m_root = z->right;
+        } else {
+            m_root = splay(z->left, k);
+            m_root->right = z->right;
+        }
+    }
+    m_pool.release(z);
+    m_size--;
+}
+
+#endif // SPLAY_TREE_HPP
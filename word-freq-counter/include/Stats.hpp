@@ -0,0 +1,60 @@
+#ifndef STATS_HPP
+#define STATS_HPP
+
+#include <cstddef>
+#include <iostream>
+
+// Políticas de instrumentação, passadas como parâmetro Stats de AVL,
+// RedBlackTree e ChainedHashTable. As estruturas chamam os ganchos abaixo
+// em todo caminho quente; com NoStats (o padrão) eles são vazios e somem
+// na compilação, com CountingStats viram contadores e mensagens de log.
+
+// Contagens acumuladas, iguais para todas as estruturas
+struct StatsReport {
+    size_t comparisons = 0;     // comparações de chave
+    size_t rotations = 0;       // rotações (árvores)
+    size_t recolorings = 0;     // trocas de cor (rubro-negra)
+    size_t probes = 0;          // nós visitados nas cadeias (hash)
+
+    void print(std::ostream& out) const {
+        out << "comparações: " << comparisons << '\n'
+            << "rotações: " << rotations << '\n'
+            << "recolorações: " << recolorings << '\n'
+            << "sondagens: " << probes << '\n';
+    }
+};
+
+struct NoStats {
+    static constexpr bool enabled = false;
+
+    void comparison() {}
+    void rotation() {}
+    void recoloring() {}
+    void probe() {}
+    template <typename... Args>
+    void log(const Args&...) {}
+
+    StatsReport report() const { return StatsReport(); }
+    void reset() {}
+};
+
+struct CountingStats {
+    static constexpr bool enabled = true;
+
+    void comparison() { m_report.comparisons++; }
+    void rotation() { m_report.rotations++; }
+    void recoloring() { m_report.recolorings++; }
+    void probe() { m_report.probes++; }
+    template <typename... Args>
+    void log(const Args&... args) {
+        (std::cout << ... << args) << '\n';
+    }
+
+    StatsReport report() const { return m_report; }
+    void reset() { m_report = StatsReport(); }
+
+private:
+    StatsReport m_report;
+};
+
+#endif // STATS_HPP
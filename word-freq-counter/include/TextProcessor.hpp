@@ -1,13 +1,37 @@
 #ifndef TEXTPROCESSOR_HPP
 #define TEXTPROCESSOR_HPP
 
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
+#include "OverlappedReader.hpp"
 
 // Limpa uma palavra: remove pontuações e converte para minúsculas
 std::string cleanWord(const std::string& raw);
 
-// Lê um arquivo .txt e retorna as palavras processadas
-std::vector<std::string> readAndProcessText(const std::string& filepath);
+// Lê um arquivo .txt e retorna as palavras processadas. Com mais de uma
+// thread (e sem direct_io) usa tokenizeChunks; a sequência é a mesma.
+std::vector<std::string> readAndProcessText(const std::string& filepath,
+                                            const ReadOptions& options = ReadOptions(),
+                                            unsigned threads = 1);
+
+// Mapeia o arquivo em memória, corta-o em trechos de ~chunk_bytes logo após
+// um separador e separa as palavras dos trechos em paralelo. Os separadores
+// são ASCII, então o corte nunca cai dentro de um caractere UTF-8 nem de
+// uma palavra (e as regras de hífen de cleanWord ficam dentro dela).
+// Devolve as palavras de cada trecho, na ordem do arquivo.
+std::vector<std::vector<std::string>> tokenizeChunks(const std::string& filepath, unsigned threads,
+                                                     size_t chunk_bytes = 256 << 10);
+
+// Entrega cada palavra processada à medida que o arquivo é lido. Com
+// [begin, end) lê só esse trecho, que deve começar e terminar entre palavras.
+void forEachWord(const std::string& filepath, const std::function<void(const std::string&)>& func,
+                 const ReadOptions& options = ReadOptions(),
+                 uint64_t begin = 0, uint64_t end = UINT64_MAX);
+
+// Primeiro deslocamento >= offset que começa uma palavra nova (logo após um
+// separador), ou o tamanho do arquivo
+uint64_t nextWordBoundary(const std::string& filepath, uint64_t offset);
 
 #endif
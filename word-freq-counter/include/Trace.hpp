@@ -0,0 +1,88 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Operações de dicionário gravadas num trace
+enum class TraceOp : uint8_t { Insert, Get, Update, Remove };
+
+struct TraceEntry {
+    TraceOp op;
+    uint32_t key;       // índice em Trace::keys
+    int64_t value;      // só em Update
+};
+
+// Sequência de operações com as chaves internadas: cada chave distinta
+// aparece uma vez em keys e as operações a referenciam pelo índice, então
+// a reprodução não constrói strings
+struct Trace {
+    std::vector<std::string> keys;
+    std::vector<TraceEntry> ops;
+};
+
+// Grava operações à medida que acontecem, internando as chaves
+class TraceRecorder {
+public:
+    void insert(const std::string& key);
+    void get(const std::string& key);
+    void update(const std::string& key, int64_t value);
+    void remove(const std::string& key);
+
+    const Trace& trace() const;
+    Trace release();
+
+private:
+    Trace m_trace;
+    std::unordered_map<std::string, uint32_t> m_ids;
+
+    uint32_t intern(const std::string& key);
+};
+
+// Proporções de cada operação no trace sintetizado; o restante são as
+// operações do trace de origem, na ordem original
+struct TraceMix {
+    double get = 0;
+    double update = 0;
+    double remove = 0;
+};
+
+// Intercala no trace de origem leituras, atualizações e remoções de chaves
+// presentes, sorteadas com a semente dada. Remoções só atingem chaves com
+// contagem 1, onde remove apaga a chave em todas as estruturas.
+Trace synthesizeTrace(const Trace& source, const TraceMix& mix, uint64_t seed = 42);
+
+// Formato binário: "FQTR", versão, chaves (tamanho + bytes) e operações
+// (código + índice da chave [+ valor]), inteiros em varint
+void writeTrace(const std::string& path, const Trace& trace);
+Trace readTrace(const std::string& path);
+
+// Resultado de uma reprodução: o checksum soma os valores lidos e o tamanho
+// final, e deve ser igual em todas as estruturas
+struct ReplayResult {
+    size_t counts[4] = {0, 0, 0, 0};    // operações por TraceOp
+    long long checksum = 0;
+};
+
+// Aplica o trace ao dicionário. O trace deve ser válido para ele: Get e
+// Update só em chaves presentes.
+template <typename Dict>
+ReplayResult replayTrace(Dict& dict, const Trace& trace) {
+    ReplayResult result;
+    for (const auto& e : trace.ops) {
+        const std::string& key = trace.keys[e.key];
+        switch (e.op) {
+        case TraceOp::Insert: dict.insert(key); break;
+        case TraceOp::Get: result.checksum += dict.get(key); break;
+        case TraceOp::Update: dict.update(key, e.value); break;
+        case TraceOp::Remove: dict.remove(key); break;
+        }
+        result.counts[static_cast<int>(e.op)]++;
+    }
+    result.checksum += dict.size();
+    return result;
+}
+
+#endif
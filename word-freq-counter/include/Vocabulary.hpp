@@ -0,0 +1,105 @@
+#ifndef VOCABULARY_HPP
+#define VOCABULARY_HPP
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Texto codificado: cada palavra distinta recebe um id denso na ordem da
+// primeira ocorrência e o texto vira a sequência desses ids. Contar de novo
+// passa a ser counts[id]++ num vetor contíguo, sem hash nem comparação de
+// strings.
+struct EncodedCorpus {
+    std::vector<std::string> words;     // id → palavra
+    std::vector<uint32_t> ids;
+};
+
+// Palavra → id denso, na ordem da primeira ocorrência. Dict é qualquer um
+// dos dicionários, guardando o id como valor; cada palavra custa uma única
+// busca (insert_or_get).
+template <typename Dict>
+class Vocabulary {
+public:
+    // Id da palavra, criando um novo se ela ainda não apareceu
+    uint32_t intern(const std::string& word);
+
+    const std::string& word(uint32_t id) const;
+    size_t size() const;
+    std::vector<std::string> release();
+
+private:
+    Dict m_ids;
+    std::vector<std::string> m_words;
+};
+
+template <typename Dict>
+uint32_t Vocabulary<Dict>::intern(const std::string& word) {
+    uint32_t next = m_words.size();
+    uint32_t id = m_ids.insert_or_get(word, next);
+    if (id == next) m_words.push_back(word);
+    return id;
+}
+
+template <typename Dict>
+const std::string& Vocabulary<Dict>::word(uint32_t id) const {
+    return m_words[id];
+}
+
+template <typename Dict>
+size_t Vocabulary<Dict>::size() const {
+    return m_words.size();
+}
+
+template <typename Dict>
+std::vector<std::string> Vocabulary<Dict>::release() {
+    m_ids.clear();
+    return std::move(m_words);
+}
+
+// Monta o vocabulário enquanto codifica o texto
+template <typename Dict>
+class VocabularyBuilder {
+public:
+    uint32_t add(const std::string& word);
+
+    size_t size() const;
+    EncodedCorpus release();
+
+private:
+    Vocabulary<Dict> m_vocabulary;
+    std::vector<uint32_t> m_ids;
+};
+
+template <typename Dict>
+uint32_t VocabularyBuilder<Dict>::add(const std::string& word) {
+    uint32_t id = m_vocabulary.intern(word);
+    m_ids.push_back(id);
+    return id;
+}
+
+template <typename Dict>
+size_t VocabularyBuilder<Dict>::size() const {
+    return m_vocabulary.size();
+}
+
+template <typename Dict>
+EncodedCorpus VocabularyBuilder<Dict>::release() {
+    EncodedCorpus corpus;
+    corpus.words = m_vocabulary.release();
+    corpus.ids = std::move(m_ids);
+    return corpus;
+}
+
+// Formato binário: "FQID", versão, vocabulário (tamanho + bytes, em varint),
+// número de ids em varint e os ids em uint32 little-endian. A largura fixa
+// deixa cada thread começar sua fatia direto pelo deslocamento.
+void writeCorpus(const std::string& path, const EncodedCorpus& corpus);
+EncodedCorpus readCorpus(const std::string& path);
+
+// Contagem de cada id em [0, vocabulary). Cada thread conta uma fatia dos
+// ids num vetor próprio; a redução soma os vetores posição a posição, um
+// laço que o compilador vetoriza, e também é dividida entre as threads.
+std::vector<uint64_t> countIds(const std::vector<uint32_t>& ids, size_t vocabulary, unsigned threads = 1);
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef WORK_STEALING_POOL_HPP
+#define WORK_STEALING_POOL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Pool de threads com roubo de trabalho: cada thread tem sua própria fila,
+// consome do início dela (na ordem de submissão, maiores primeiro quando
+// vêm de planBatch) e, quando fica sem tarefas, rouba do fim da fila de
+// outra. As tarefas recebem o índice da thread que as executa, para
+// que cada uma acumule resultados em estado próprio, sem sincronização.
+class WorkStealingPool {
+public:
+    using Task = std::function<void(unsigned worker)>;
+
+    explicit WorkStealingPool(unsigned workers);
+
+    // Distribui em rodízio; chamar antes de run()
+    void submit(Task task);
+
+    // Executa todas as tarefas e volta quando terminarem; a primeira
+    // exceção lançada por uma tarefa é relançada aqui
+    void run();
+
+    unsigned workers() const;
+    size_t steals() const;
+
+private:
+    struct Queue {
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    size_t m_next;
+    std::atomic<size_t> m_remaining;
+    std::atomic<size_t> m_steals;
+    std::mutex m_error_lock;
+    std::exception_ptr m_error;
+
+    bool pop(unsigned worker, Task& task);
+    bool steal(unsigned worker, Task& task);
+    void work(unsigned worker);
+};
+
+#endif
@@ -0,0 +1,73 @@
+#include "BatchJob.hpp"
+#include "TextProcessor.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+#include <glob.h>
+
+namespace fs = std::filesystem;
+
+static bool isGlob(const std::string& s) {
+    return s.find_first_of("*?[") != std::string::npos;
+}
+
+static void addPath(const fs::path& path, std::vector<std::string>& files) {
+    if (fs::is_directory(path)) {
+        for (const auto& entry : fs::recursive_directory_iterator(path)) {
+            if (entry.is_regular_file()) files.push_back(entry.path().string());
+        }
+    } else if (fs::is_regular_file(path)) {
+        files.push_back(path.string());
+    } else {
+        throw std::runtime_error("Failed to open file: " + path.string());
+    }
+}
+
+std::vector<std::string> expandInputs(const std::vector<std::string>& inputs) {
+    std::vector<std::string> files;
+    for (const auto& input : inputs) {
+        if (isGlob(input) && !fs::exists(input)) {
+            glob_t matches;
+            if (::glob(input.c_str(), 0, nullptr, &matches) != 0) {
+                ::globfree(&matches);
+                throw std::runtime_error("Nenhum arquivo corresponde a: " + input);
+            }
+            for (size_t i = 0; i < matches.gl_pathc; i++) addPath(matches.gl_pathv[i], files);
+            ::globfree(&matches);
+        } else {
+            addPath(input, files);
+        }
+    }
+    std::sort(files.begin(), files.end());
+    files.erase(std::unique(files.begin(), files.end()), files.end());
+    return files;
+}
+
+std::vector<BatchTask> planBatch(const std::vector<std::string>& files, uint64_t chunk_bytes) {
+    std::vector<BatchTask> tasks;
+    BatchTask small{{}, 0};
+    for (size_t i = 0; i < files.size(); i++) {
+        uint64_t size = fs::file_size(files[i]);
+        if (size <= chunk_bytes) {
+            small.pieces.push_back(BatchPiece{i, 0, size});
+            small.bytes += size;
+            if (small.bytes >= chunk_bytes) {
+                tasks.push_back(std::move(small));
+                small = BatchTask{{}, 0};
+            }
+            continue;
+        }
+        uint64_t begin = 0;
+        while (begin < size) {
+            uint64_t end = begin + chunk_bytes >= size ? size
+                         : std::min(size, nextWordBoundary(files[i], begin + chunk_bytes));
+            tasks.push_back(BatchTask{{BatchPiece{i, begin, end}}, end - begin});
+            begin = end;
+        }
+    }
+    if (!small.pieces.empty()) tasks.push_back(std::move(small));
+    std::stable_sort(tasks.begin(), tasks.end(), [](const BatchTask& a, const BatchTask& b) {
+        return a.bytes > b.bytes;
+    });
+    return tasks;
+}
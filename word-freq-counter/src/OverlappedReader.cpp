@@ -0,0 +1,156 @@
+#include "OverlappedReader.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Alinhamento exigido por O_DIRECT na maioria dos sistemas de arquivos
+static const size_t IO_ALIGNMENT = 4096;
+
+OverlappedReader::OverlappedReader(const std::string& filepath, const ReadOptions& options,
+                                   uint64_t begin, uint64_t end) {
+    m_fd = -1;
+    m_direct = false;
+#ifdef O_DIRECT
+    if (options.direct_io) {
+        m_fd = ::open(filepath.c_str(), O_RDONLY | O_DIRECT);
+        m_direct = m_fd >= 0;
+    }
+#endif
+    if (m_fd < 0) m_fd = ::open(filepath.c_str(), O_RDONLY);
+    if (m_fd < 0) {
+        throw std::runtime_error("Failed to open file: " + filepath);
+    }
+#ifdef POSIX_FADV_SEQUENTIAL
+    ::posix_fadvise(m_fd, begin, end == UINT64_MAX ? 0 : end - begin, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    struct stat st;
+    uint64_t file_size = ::fstat(m_fd, &st) == 0 && S_ISREG(st.st_mode) ? st.st_size : UINT64_MAX;
+    m_begin = begin;
+    m_end = std::min(end, file_size);
+    m_offset = m_direct ? begin / IO_ALIGNMENT * IO_ALIGNMENT : begin;
+
+    m_buffer_size = (std::max<size_t>(options.buffer_size, 1) + IO_ALIGNMENT - 1) / IO_ALIGNMENT * IO_ALIGNMENT;
+    m_sync = m_end != UINT64_MAX && m_end <= m_offset + m_buffer_size;
+    m_ring.resize(m_sync ? 1 : std::max<size_t>(options.buffers, 2));
+    for (auto& b : m_ring) {
+        void* p = nullptr;
+        if (::posix_memalign(&p, IO_ALIGNMENT, m_buffer_size) != 0) {
+            for (auto& other : m_ring) std::free(other.data);
+            ::close(m_fd);
+            throw std::bad_alloc();
+        }
+        b.data = static_cast<char*>(p);
+        b.start = b.length = 0;
+    }
+    m_filled = m_consumed = 0;
+    m_holding = m_eof = m_stop = false;
+    if (!m_sync) m_thread = std::thread(&OverlappedReader::run, this);
+}
+
+OverlappedReader::~OverlappedReader() {
+    if (m_thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            m_stop = true;
+        }
+        m_has_space.notify_one();
+        m_thread.join();
+    }
+    for (auto& b : m_ring) std::free(b.data);
+    ::close(m_fd);
+}
+
+bool OverlappedReader::next(const char*& data, size_t& length) {
+    if (m_sync) {
+        if (m_eof) return false;
+        std::string error;
+        bool eof;
+        bool got = fill(m_ring[0], eof, error);
+        m_eof = true;
+        if (!error.empty()) throw std::runtime_error(error);
+        data = m_ring[0].data + m_ring[0].start;
+        length = m_ring[0].length;
+        return got;
+    }
+
+    std::unique_lock<std::mutex> guard(m_lock);
+    if (m_holding) {
+        m_consumed++;
+        m_holding = false;
+        m_has_space.notify_one();
+    }
+    m_has_data.wait(guard, [&] { return m_filled > m_consumed || m_eof; });
+    if (m_filled == m_consumed) {
+        if (!m_error.empty()) throw std::runtime_error(m_error);
+        return false;
+    }
+    const Buffer& b = m_ring[m_consumed % m_ring.size()];
+    data = b.data + b.start;
+    length = b.length;
+    m_holding = true;
+    return true;
+}
+
+// Lê o próximo buffer e recorta o que estiver fora de [m_begin, m_end).
+// Devolve false quando não sobrou nada do trecho.
+bool OverlappedReader::fill(Buffer& b, bool& eof, std::string& error) {
+    uint64_t want = m_buffer_size;
+    if (m_end != UINT64_MAX) {
+        uint64_t left = m_end > m_offset ? m_end - m_offset : 0;
+        if (m_direct) left = (left + IO_ALIGNMENT - 1) / IO_ALIGNMENT * IO_ALIGNMENT;
+        want = std::min(want, left);
+    }
+    size_t got = 0;
+    while (got < want) {
+        ssize_t n = ::pread(m_fd, b.data + got, want - got, m_offset + got);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) {
+            error = std::string("Erro de leitura: ") + std::strerror(errno);
+            break;
+        }
+        if (n == 0) break;
+        got += n;
+        // Com O_DIRECT uma leitura curta só acontece no fim do arquivo, e
+        // o próximo deslocamento já não estaria alinhado
+        if (m_direct && got % IO_ALIGNMENT != 0) break;
+    }
+
+    uint64_t first = m_offset;
+    m_offset += got;
+    b.start = m_begin > first ? std::min<uint64_t>(m_begin - first, got) : 0;
+    uint64_t last = std::min<uint64_t>(m_offset, m_end);
+    b.length = last > first + b.start ? last - first - b.start : 0;
+    eof = got < want || m_offset >= m_end || !error.empty();
+    return b.length > 0;
+}
+
+// Thread leitora: preenche o próximo buffer livre fora da trava e só
+// então o publica
+void OverlappedReader::run() {
+    while (true) {
+        size_t slot;
+        {
+            std::unique_lock<std::mutex> guard(m_lock);
+            m_has_space.wait(guard, [&] { return m_filled - m_consumed < m_ring.size() || m_stop; });
+            if (m_stop) return;
+            slot = m_filled % m_ring.size();
+        }
+
+        std::string error;
+        bool eof;
+        bool got = fill(m_ring[slot], eof, error);
+
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (got) m_filled++;
+        m_eof = eof;
+        m_error = error;
+        m_has_data.notify_one();
+        if (m_eof) return;
+    }
+}
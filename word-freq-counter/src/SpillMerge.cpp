@@ -0,0 +1,205 @@
+#include "SpillMerge.hpp"
+#include "Utils.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <stdlib.h>
+
+namespace fs = std::filesystem;
+
+// Buffer de cada arquivo de run, para a fusão de muitas runs não virar
+// leituras pequenas
+static const size_t RUN_BUFFER = 64 << 10;
+
+namespace {
+
+class RunWriter {
+public:
+    explicit RunWriter(const std::string& path) : m_buffer(RUN_BUFFER), m_bytes(0) {
+        m_out.rdbuf()->pubsetbuf(m_buffer.data(), m_buffer.size());
+        m_out.open(path, std::ios::binary | std::ios::trunc);
+        if (!m_out) throw std::runtime_error("Erro ao criar run: " + path);
+    }
+
+    void add(const std::string& key, int64_t count) {
+        putVarint(key.size());
+        m_out.write(key.data(), key.size());
+        putVarint(count);
+        m_bytes += key.size();
+    }
+
+    uint64_t close() {
+        m_out.flush();
+        if (!m_out) throw std::runtime_error("Erro ao gravar run (disco cheio?)");
+        m_out.close();
+        return m_bytes;
+    }
+
+private:
+    std::vector<char> m_buffer;
+    std::ofstream m_out;
+    uint64_t m_bytes;
+
+    void putVarint(uint64_t v) {
+        while (v >= 0x80) {
+            m_out.put(static_cast<char>(v | 0x80));
+            v >>= 7;
+            m_bytes++;
+        }
+        m_out.put(static_cast<char>(v));
+        m_bytes++;
+    }
+};
+
+class RunReader {
+public:
+    explicit RunReader(const std::string& path) : m_buffer(RUN_BUFFER), m_bytes(0) {
+        m_in.rdbuf()->pubsetbuf(m_buffer.data(), m_buffer.size());
+        m_in.open(path, std::ios::binary);
+        if (!m_in) throw std::runtime_error("Failed to open file: " + path);
+    }
+
+    // Lê a próxima entrada; false no fim da run
+    bool next() {
+        uint64_t len;
+        if (!getVarint(len, true)) return false;
+        key.resize(len);
+        if (!m_in.read(&key[0], len)) throw std::runtime_error("Run truncada");
+        m_bytes += len;
+        uint64_t c;
+        getVarint(c, false);
+        count = c;
+        return true;
+    }
+
+    uint64_t bytes() const { return m_bytes; }
+
+    std::string key;
+    int64_t count = 0;
+
+private:
+    std::vector<char> m_buffer;
+    std::ifstream m_in;
+    uint64_t m_bytes;
+
+    bool getVarint(uint64_t& v, bool eofOk) {
+        v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            int b = m_in.get();
+            if (b == EOF) {
+                if (eofOk && shift == 0) return false;
+                throw std::runtime_error("Run truncada");
+            }
+            m_bytes++;
+            v |= uint64_t(b & 0x7f) << shift;
+            if (!(b & 0x80)) return true;
+        }
+        throw std::runtime_error("Run corrompida");
+    }
+};
+
+}
+
+SpillSet::SpillSet(const std::string& temp_dir) : m_next_id(0) {
+    fs::path base = temp_dir.empty() ? fs::temp_directory_path() : fs::path(temp_dir);
+    std::string tmpl = (base / "freq-spill-XXXXXX").string();
+    if (::mkdtemp(&tmpl[0]) == nullptr) {
+        throw std::runtime_error("Erro ao criar diretório temporário em " + base.string() + ": " + std::strerror(errno));
+    }
+    m_dir = tmpl;
+}
+
+SpillSet::~SpillSet() {
+    std::error_code ec;
+    fs::remove_all(m_dir, ec);
+}
+
+std::string SpillSet::newRunPath() {
+    return (fs::path(m_dir) / ("run" + std::to_string(m_next_id++))).string();
+}
+
+void SpillSet::spill(std::vector<std::pair<const std::string*, int>>& entries) {
+    Timer t;
+    t.begin();
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+        return *a.first < *b.first;
+    });
+    std::string path = newRunPath();
+    RunWriter writer(path);
+    for (const auto& e : entries) writer.add(*e.first, e.second);
+    m_stats.bytes_written += writer.close();
+    m_runs.push_back(path);
+    m_stats.runs++;
+    t.stop();
+    m_stats.spill_ms += t.durationMs();
+}
+
+// Fusão de k runs com um heap mínimo pela chave atual de cada uma
+void SpillSet::mergeRuns(const std::vector<std::string>& runs,
+                         const std::function<void(const std::string&, int64_t)>& func) {
+    std::vector<std::unique_ptr<RunReader>> readers;
+    for (const auto& path : runs) readers.emplace_back(new RunReader(path));
+
+    auto greater = [&](size_t a, size_t b) { return readers[a]->key > readers[b]->key; };
+    std::priority_queue<size_t, std::vector<size_t>, decltype(greater)> heap(greater);
+    for (size_t i = 0; i < readers.size(); i++) {
+        if (readers[i]->next()) heap.push(i);
+    }
+
+    std::string key;
+    int64_t total = 0;
+    bool pending = false;
+    while (!heap.empty()) {
+        size_t i = heap.top();
+        heap.pop();
+        if (pending && readers[i]->key != key) {
+            func(key, total);
+            pending = false;
+        }
+        if (!pending) {
+            key = readers[i]->key;
+            total = 0;
+            pending = true;
+        }
+        total += readers[i]->count;
+        if (readers[i]->next()) heap.push(i);
+    }
+    if (pending) func(key, total);
+
+    for (const auto& r : readers) m_stats.bytes_read += r->bytes();
+    for (const auto& path : runs) std::remove(path.c_str());
+}
+
+void SpillSet::merge(const std::function<void(const std::string&, int64_t)>& func) {
+    Timer t;
+    t.begin();
+    // Passadas intermediárias até caber num só heap sem estourar os descritores
+    while (m_runs.size() > MERGE_FAN_IN) {
+        std::vector<std::string> group(m_runs.begin(), m_runs.begin() + MERGE_FAN_IN);
+        m_runs.erase(m_runs.begin(), m_runs.begin() + MERGE_FAN_IN);
+        std::string path = newRunPath();
+        RunWriter writer(path);
+        mergeRuns(group, [&](const std::string& key, int64_t count) { writer.add(key, count); });
+        m_stats.bytes_written += writer.close();
+        m_runs.push_back(path);
+        m_stats.passes++;
+    }
+    mergeRuns(m_runs, func);
+    m_runs.clear();
+    t.stop();
+    m_stats.merge_ms += t.durationMs();
+}
+
+size_t SpillSet::runs() const {
+    return m_runs.size();
+}
+
+const SpillStats& SpillSet::stats() const {
+    return m_stats;
+}
@@ -1,10 +1,17 @@
 #include "TextProcessor.hpp"
 #include <fstream>
-#include <sstream>
+#include <stdexcept>
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <atomic>
+#include <iterator>
 #include <cctype>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 // Lista de letras válidas (acentuadas + padrão ASCII)
 const std::string validChars =
@@ -43,26 +50,176 @@ std::string cleanWord(const std::string& raw) {
     return result;
 }
 
+// Separadores de palavra, os mesmos de operator>> no locale "C"
+static bool isSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// Lê o arquivo pelo OverlappedReader e separa as palavras buffer a buffer.
+// Uma palavra cortada no fim de um buffer fica em 'pending' até o próximo.
+void forEachWord(const std::string& filepath, const std::function<void(const std::string&)>& func,
+                 const ReadOptions& options, uint64_t begin, uint64_t end) {
+    OverlappedReader reader(filepath, options, begin, end);
+    std::string pending, raw;
+    const char* data;
+    size_t length;
+
+    while (reader.next(data, length)) {
+        const char* end = data + length;
+        const char* p = data;
+        while (p < end) {
+            while (p < end && isSpace(*p)) {
+                if (!pending.empty()) {
+                    std::string cleaned = cleanWord(pending);
+                    if (!cleaned.empty()) func(cleaned);
+                    pending.clear();
+                }
+                ++p;
+            }
+            const char* start = p;
+            while (p < end && !isSpace(*p)) ++p;
+            if (p == start) continue;
+            if (p == end) {
+                pending.append(start, p);
+            } else if (pending.empty()) {
+                raw.assign(start, p);
+                std::string cleaned = cleanWord(raw);
+                if (!cleaned.empty()) func(cleaned);
+            } else {
+                pending.append(start, p);
+                std::string cleaned = cleanWord(pending);
+                if (!cleaned.empty()) func(cleaned);
+                pending.clear();
+            }
+        }
+    }
+    if (!pending.empty()) {
+        std::string cleaned = cleanWord(pending);
+        if (!cleaned.empty()) func(cleaned);
+    }
+}
+
 // Lê e processa o texto
-std::vector<std::string> readAndProcessText(const std::string& filepath) {
-    std::ifstream file(filepath);
+std::vector<std::string> readAndProcessText(const std::string& filepath, const ReadOptions& options,
+                                            unsigned threads) {
     std::vector<std::string> words;
-    std::string line;
+    if (threads > 1 && !options.direct_io) {
+        auto chunks = tokenizeChunks(filepath, threads);
+        size_t total = 0;
+        for (const auto& c : chunks) total += c.size();
+        words.reserve(total);
+        for (auto& c : chunks) {
+            std::move(c.begin(), c.end(), std::back_inserter(words));
+            std::vector<std::string>().swap(c);
+        }
+        return words;
+    }
+    forEachWord(filepath, [&](const std::string& word) {
+        words.push_back(word);
+    }, options);
+    return words;
+}
 
-    if (!file.is_open()) {
-        throw std::runtime_error("Failed to open file: " + filepath);
+// Separa as palavras de um trecho contíguo que começa e termina entre palavras
+static void tokenizeRange(const char* p, const char* end, std::vector<std::string>& out) {
+    std::string raw;
+    while (p < end) {
+        while (p < end && isSpace(*p)) ++p;
+        const char* start = p;
+        while (p < end && !isSpace(*p)) ++p;
+        if (p == start) continue;
+        raw.assign(start, p);
+        std::string cleaned = cleanWord(raw);
+        if (!cleaned.empty()) out.push_back(std::move(cleaned));
     }
+}
 
-    while (std::getline(file, line)) {
-        std::stringstream ss(line);
-        std::string word;
-        while (ss >> word) {
-            std::string cleaned = cleanWord(word);
-            if (!cleaned.empty()) {
-                words.push_back(cleaned);
+// Arquivo mapeado só para leitura, desfeito no destrutor
+namespace {
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& filepath) : m_data(nullptr), m_size(0) {
+        int fd = ::open(filepath.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("Failed to open file: " + filepath);
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Failed to open file: " + filepath);
+        }
+        m_size = st.st_size;
+        if (m_size > 0) {
+            void* p = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Erro ao mapear arquivo: " + filepath);
             }
+            m_data = static_cast<const char*>(p);
+            ::madvise(p, m_size, MADV_SEQUENTIAL);
         }
+        ::close(fd);
     }
 
-    return words;
+    ~MappedFile() {
+        if (m_data != nullptr) ::munmap(const_cast<char*>(m_data), m_size);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    const char* m_data;
+    size_t m_size;
+};
+}
+
+std::vector<std::vector<std::string>> tokenizeChunks(const std::string& filepath, unsigned threads,
+                                                     size_t chunk_bytes) {
+    MappedFile file(filepath);
+    const char* data = file.data();
+    size_t size = file.size();
+    chunk_bytes = std::max<size_t>(chunk_bytes, 4096);
+
+    // Cada corte avança até logo depois de um separador
+    std::vector<size_t> cuts{0};
+    while (cuts.back() < size) {
+        size_t cut = std::min(size, cuts.back() + chunk_bytes);
+        while (cut < size && !isSpace(data[cut - 1])) ++cut;
+        cuts.push_back(cut);
+    }
+
+    std::vector<std::vector<std::string>> chunks(cuts.size() - 1);
+    std::atomic<size_t> next(0);
+    auto work = [&] {
+        for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < chunks.size();) {
+            // ~6 bytes por palavra no texto corrido
+            chunks[i].reserve((cuts[i + 1] - cuts[i]) / 6);
+            tokenizeRange(data + cuts[i], data + cuts[i + 1], chunks[i]);
+        }
+    };
+    threads = std::max<size_t>(1, std::min<size_t>(threads, chunks.size()));
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; t++) workers.emplace_back(work);
+    work();
+    for (auto& w : workers) w.join();
+    return chunks;
+}
+
+uint64_t nextWordBoundary(const std::string& filepath, uint64_t offset) {
+    if (offset == 0) return 0;
+    std::ifstream file(filepath, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file: " + filepath);
+    }
+    file.seekg(offset - 1);
+    char buffer[4096];
+    while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0) {
+        for (std::streamsize i = 0; i < file.gcount(); i++) {
+            if (isSpace(buffer[i])) return offset + i;
+        }
+        offset += file.gcount();
+    }
+    return offset - 1;
 }
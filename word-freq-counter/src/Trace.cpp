@@ -0,0 +1,213 @@
+#include "Trace.hpp"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+static const char TRACE_MAGIC[4] = {'F', 'Q', 'T', 'R'};
+static const uint8_t TRACE_VERSION = 1;
+
+uint32_t TraceRecorder::intern(const std::string& key) {
+    auto it = m_ids.find(key);
+    if (it != m_ids.end()) return it->second;
+    uint32_t id = m_trace.keys.size();
+    m_trace.keys.push_back(key);
+    m_ids.emplace(key, id);
+    return id;
+}
+
+void TraceRecorder::insert(const std::string& key) {
+    m_trace.ops.push_back({TraceOp::Insert, intern(key), 0});
+}
+
+void TraceRecorder::get(const std::string& key) {
+    m_trace.ops.push_back({TraceOp::Get, intern(key), 0});
+}
+
+void TraceRecorder::update(const std::string& key, int64_t value) {
+    m_trace.ops.push_back({TraceOp::Update, intern(key), value});
+}
+
+void TraceRecorder::remove(const std::string& key) {
+    m_trace.ops.push_back({TraceOp::Remove, intern(key), 0});
+}
+
+const Trace& TraceRecorder::trace() const {
+    return m_trace;
+}
+
+Trace TraceRecorder::release() {
+    m_ids.clear();
+    return std::move(m_trace);
+}
+
+// Conjunto de índices de chave com inserção, remoção e sorteio em O(1)
+namespace {
+class KeySet {
+public:
+    explicit KeySet(size_t keys) : m_pos(keys, -1) {}
+
+    bool empty() const { return m_items.empty(); }
+    bool contains(uint32_t k) const { return m_pos[k] >= 0; }
+
+    void add(uint32_t k) {
+        if (contains(k)) return;
+        m_pos[k] = m_items.size();
+        m_items.push_back(k);
+    }
+
+    void erase(uint32_t k) {
+        if (!contains(k)) return;
+        uint32_t last = m_items.back();
+        m_items[m_pos[k]] = last;
+        m_pos[last] = m_pos[k];
+        m_items.pop_back();
+        m_pos[k] = -1;
+    }
+
+    template <typename Rng>
+    uint32_t pick(Rng& rng) const {
+        return m_items[std::uniform_int_distribution<size_t>(0, m_items.size() - 1)(rng)];
+    }
+
+private:
+    std::vector<uint32_t> m_items;
+    std::vector<long long> m_pos;
+};
+}
+
+Trace synthesizeTrace(const Trace& source, const TraceMix& mix, uint64_t seed) {
+    if (mix.get < 0 || mix.update < 0 || mix.remove < 0 || mix.get + mix.update + mix.remove >= 1) {
+        throw std::invalid_argument("Proporções do trace devem somar menos de 100%");
+    }
+    Trace out;
+    out.keys = source.keys;
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    std::uniform_int_distribution<int64_t> newValue(1, 8);
+
+    // Modelo das contagens, para só gerar operações válidas
+    std::vector<int64_t> count(source.keys.size(), 0);
+    KeySet present(source.keys.size()), singles(source.keys.size());
+    auto setCount = [&](uint32_t k, int64_t c) {
+        count[k] = c;
+        if (c > 0) present.add(k); else present.erase(k);
+        if (c == 1) singles.add(k); else singles.erase(k);
+    };
+
+    size_t next = 0;
+    while (next < source.ops.size()) {
+        double u = coin(rng);
+        if (u < mix.get && !present.empty()) {
+            out.ops.push_back({TraceOp::Get, present.pick(rng), 0});
+        } else if (u < mix.get + mix.update && !present.empty()) {
+            uint32_t k = present.pick(rng);
+            int64_t v = newValue(rng);
+            out.ops.push_back({TraceOp::Update, k, v});
+            setCount(k, v);
+        } else if (u < mix.get + mix.update + mix.remove && !singles.empty()) {
+            uint32_t k = singles.pick(rng);
+            out.ops.push_back({TraceOp::Remove, k, 0});
+            setCount(k, 0);
+        } else {
+            const TraceEntry& e = source.ops[next++];
+            out.ops.push_back(e);
+            if (e.op == TraceOp::Insert) setCount(e.key, count[e.key] + 1);
+            else if (e.op == TraceOp::Update) setCount(e.key, e.value);
+            else if (e.op == TraceOp::Remove) setCount(e.key, 0);
+        }
+    }
+    return out;
+}
+
+static void putVarint(std::string& buf, uint64_t v) {
+    while (v >= 0x80) {
+        buf.push_back(static_cast<char>(v | 0x80));
+        v >>= 7;
+    }
+    buf.push_back(static_cast<char>(v));
+}
+
+static uint64_t getVarint(const std::string& buf, size_t& pos) {
+    uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos >= buf.size()) throw std::runtime_error("Trace truncado");
+        uint8_t b = buf[pos++];
+        v |= uint64_t(b & 0x7f) << shift;
+        if (!(b & 0x80)) return v;
+    }
+    throw std::runtime_error("Trace corrompido: varint longo demais");
+}
+
+// Valores com sinal em zigzag, para negativos pequenos ocuparem poucos bytes
+static uint64_t zigzag(int64_t v) {
+    return (uint64_t(v) << 1) ^ uint64_t(v >> 63);
+}
+
+static int64_t unzigzag(uint64_t v) {
+    return int64_t(v >> 1) ^ -int64_t(v & 1);
+}
+
+void writeTrace(const std::string& path, const Trace& trace) {
+    std::string buf(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    buf.push_back(TRACE_VERSION);
+    putVarint(buf, trace.keys.size());
+    for (const auto& key : trace.keys) {
+        putVarint(buf, key.size());
+        buf += key;
+    }
+    putVarint(buf, trace.ops.size());
+    for (const auto& e : trace.ops) {
+        buf.push_back(static_cast<char>(e.op));
+        putVarint(buf, e.key);
+        if (e.op == TraceOp::Update) putVarint(buf, zigzag(e.value));
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out || !out.write(buf.data(), buf.size())) {
+        throw std::runtime_error("Erro ao gravar trace: " + path);
+    }
+}
+
+Trace readTrace(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+    std::string buf((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (buf.size() < 5 || std::memcmp(buf.data(), TRACE_MAGIC, 4) != 0) {
+        throw std::runtime_error("Não é um trace: " + path);
+    }
+    if (static_cast<uint8_t>(buf[4]) != TRACE_VERSION) {
+        throw std::runtime_error("Versão de trace não suportada: " + path);
+    }
+
+    Trace trace;
+    size_t pos = 5;
+    // Cada chave ocupa ao menos 1 byte e cada operação ao menos 2
+    size_t keys = getVarint(buf, pos);
+    if (keys > buf.size() - pos) throw std::runtime_error("Trace truncado");
+    trace.keys.resize(keys);
+    for (auto& key : trace.keys) {
+        size_t len = getVarint(buf, pos);
+        if (len > buf.size() - pos) throw std::runtime_error("Trace truncado");
+        key.assign(buf, pos, len);
+        pos += len;
+    }
+    size_t ops = getVarint(buf, pos);
+    if (ops > (buf.size() - pos) / 2) throw std::runtime_error("Trace truncado");
+    trace.ops.resize(ops);
+    for (auto& e : trace.ops) {
+        if (pos >= buf.size()) throw std::runtime_error("Trace truncado");
+        uint8_t op = buf[pos++];
+        if (op > static_cast<uint8_t>(TraceOp::Remove)) throw std::runtime_error("Trace corrompido: operação inválida");
+        e.op = static_cast<TraceOp>(op);
+        uint64_t key = getVarint(buf, pos);
+        if (key >= trace.keys.size()) throw std::runtime_error("Trace corrompido: chave inválida");
+        e.key = key;
+        e.value = e.op == TraceOp::Update ? unzigzag(getVarint(buf, pos)) : 0;
+    }
+    return trace;
+}
@@ -0,0 +1,130 @@
+#include "Vocabulary.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+
+static const char CORPUS_MAGIC[4] = {'F', 'Q', 'I', 'D'};
+static const uint8_t CORPUS_VERSION = 1;
+
+static void putVarint(std::string& buf, uint64_t v) {
+    while (v >= 0x80) {
+        buf.push_back(static_cast<char>(v | 0x80));
+        v >>= 7;
+    }
+    buf.push_back(static_cast<char>(v));
+}
+
+static uint64_t getVarint(const std::string& buf, size_t& pos) {
+    uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos >= buf.size()) throw std::runtime_error("Corpus codificado truncado");
+        uint8_t b = buf[pos++];
+        v |= uint64_t(b & 0x7f) << shift;
+        if (!(b & 0x80)) return v;
+    }
+    throw std::runtime_error("Corpus codificado corrompido: varint longo demais");
+}
+
+void writeCorpus(const std::string& path, const EncodedCorpus& corpus) {
+    std::string buf(CORPUS_MAGIC, sizeof(CORPUS_MAGIC));
+    buf.push_back(CORPUS_VERSION);
+    putVarint(buf, corpus.words.size());
+    for (const auto& word : corpus.words) {
+        putVarint(buf, word.size());
+        buf += word;
+    }
+    putVarint(buf, corpus.ids.size());
+    size_t pos = buf.size();
+    buf.resize(pos + corpus.ids.size() * 4);
+    for (uint32_t id : corpus.ids) {
+        buf[pos++] = static_cast<char>(id);
+        buf[pos++] = static_cast<char>(id >> 8);
+        buf[pos++] = static_cast<char>(id >> 16);
+        buf[pos++] = static_cast<char>(id >> 24);
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out || !out.write(buf.data(), buf.size())) {
+        throw std::runtime_error("Erro ao gravar corpus codificado: " + path);
+    }
+}
+
+EncodedCorpus readCorpus(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+    std::string buf((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (buf.size() < 5 || std::memcmp(buf.data(), CORPUS_MAGIC, 4) != 0) {
+        throw std::runtime_error("Não é um corpus codificado: " + path);
+    }
+    if (static_cast<uint8_t>(buf[4]) != CORPUS_VERSION) {
+        throw std::runtime_error("Versão de corpus codificado não suportada: " + path);
+    }
+
+    EncodedCorpus corpus;
+    size_t pos = 5;
+    size_t words = getVarint(buf, pos);
+    if (words > buf.size() - pos) throw std::runtime_error("Corpus codificado truncado");
+    corpus.words.resize(words);
+    for (auto& word : corpus.words) {
+        size_t len = getVarint(buf, pos);
+        if (len > buf.size() - pos) throw std::runtime_error("Corpus codificado truncado");
+        word.assign(buf, pos, len);
+        pos += len;
+    }
+    size_t ids = getVarint(buf, pos);
+    if (ids != (buf.size() - pos) / 4 || (buf.size() - pos) % 4 != 0) {
+        throw std::runtime_error("Corpus codificado truncado");
+    }
+    corpus.ids.resize(ids);
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(buf.data() + pos);
+    for (size_t i = 0; i < ids; i++, p += 4) {
+        uint32_t id = uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24;
+        if (id >= words) throw std::runtime_error("Corpus codificado corrompido: id inválido");
+        corpus.ids[i] = id;
+    }
+    return corpus;
+}
+
+std::vector<uint64_t> countIds(const std::vector<uint32_t>& ids, size_t vocabulary, unsigned threads) {
+    std::vector<uint64_t> total(vocabulary, 0);
+    // Fatias pequenas não pagam o vetor de contagens de cada thread
+    threads = std::max<size_t>(1, std::min<size_t>(threads, ids.size() / (vocabulary + 1)));
+    if (threads == 1) {
+        for (uint32_t id : ids) total[id]++;
+        return total;
+    }
+
+    std::vector<std::vector<uint32_t>> partial(threads);
+    std::vector<std::thread> workers;
+    size_t slice = (ids.size() + threads - 1) / threads;
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            std::vector<uint32_t>& counts = partial[t];
+            counts.assign(vocabulary, 0);
+            size_t from = std::min(ids.size(), t * slice), to = std::min(ids.size(), from + slice);
+            for (size_t i = from; i < to; i++) counts[ids[i]]++;
+        });
+    }
+    for (auto& w : workers) w.join();
+    workers.clear();
+
+    // Cada thread soma uma faixa de ids de todos os vetores parciais
+    size_t band = (vocabulary + threads - 1) / threads;
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            size_t from = std::min(vocabulary, t * band), to = std::min(vocabulary, from + band);
+            uint64_t* out = total.data();
+            for (const auto& counts : partial) {
+                const uint32_t* in = counts.data();
+                for (size_t i = from; i < to; i++) out[i] += in[i];
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+    return total;
+}
@@ -0,0 +1,79 @@
+#include "WorkStealingPool.hpp"
+#include <thread>
+
+WorkStealingPool::WorkStealingPool(unsigned workers) {
+    if (workers == 0) workers = 1;
+    for (unsigned i = 0; i < workers; i++) m_queues.emplace_back(new Queue());
+    m_next = 0;
+    m_remaining.store(0);
+    m_steals.store(0);
+}
+
+void WorkStealingPool::submit(Task task) {
+    Queue& q = *m_queues[m_next++ % m_queues.size()];
+    std::lock_guard<std::mutex> guard(q.lock);
+    q.tasks.push_back(std::move(task));
+    m_remaining++;
+}
+
+void WorkStealingPool::run() {
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < m_queues.size(); i++) {
+        threads.emplace_back(&WorkStealingPool::work, this, i);
+    }
+    work(0);
+    for (auto& t : threads) t.join();
+    if (m_error) std::rethrow_exception(m_error);
+}
+
+unsigned WorkStealingPool::workers() const {
+    return static_cast<unsigned>(m_queues.size());
+}
+
+size_t WorkStealingPool::steals() const {
+    return m_steals.load();
+}
+
+bool WorkStealingPool::pop(unsigned worker, Task& task) {
+    Queue& q = *m_queues[worker];
+    std::lock_guard<std::mutex> guard(q.lock);
+    if (q.tasks.empty()) return false;
+    task = std::move(q.tasks.front());
+    q.tasks.pop_front();
+    return true;
+}
+
+// Percorre as outras filas a partir da vizinha e leva a tarefa do fim, a
+// menor: a dona segue com as grandes e o roubo só acerta a cauda
+bool WorkStealingPool::steal(unsigned worker, Task& task) {
+    size_t n = m_queues.size();
+    for (size_t i = 1; i < n; i++) {
+        Queue& q = *m_queues[(worker + i) % n];
+        std::lock_guard<std::mutex> guard(q.lock);
+        if (q.tasks.empty()) continue;
+        task = std::move(q.tasks.back());
+        q.tasks.pop_back();
+        m_steals++;
+        return true;
+    }
+    return false;
+}
+
+// As tarefas não criam outras, então a thread pode sair quando não há
+// mais nada pendente em fila alguma
+void WorkStealingPool::work(unsigned worker) {
+    Task task;
+    while (m_remaining.load() > 0) {
+        if (pop(worker, task) || steal(worker, task)) {
+            m_remaining--;
+            try {
+                task(worker);
+            } catch (...) {
+                std::lock_guard<std::mutex> guard(m_error_lock);
+                if (!m_error) m_error = std::current_exception();
+            }
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
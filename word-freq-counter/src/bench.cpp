@@ -0,0 +1,668 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+#include <new>
+#include <malloc.h>
+#include <atomic>
+#include <thread>
+#include "../include/AVL.hpp"
+#include "../include/RedBlackTree.hpp"
+#include "../include/SplayTree.hpp"
+#include "../include/ChainedHashTable.hpp"
+#include "../include/HashFunctions.hpp"
+#include "../include/ART.hpp"
+#include "../include/FrozenDictionary.hpp"
+#include "../include/EytzingerDictionary.hpp"
+#include "../include/SnapshotRedBlackTree.hpp"
+#include "../include/SlidingWindow.hpp"
+#include "../include/ConcurrentSkipList.hpp"
+#include "../include/Trace.hpp"
+#include "../include/Vocabulary.hpp"
+#include "../include/Ngram.hpp"
+#include "../include/TextProcessor.hpp"
+#include "../include/Utils.hpp"
+
+using namespace std;
+
+// @contabilizando a memória viva do heap para comparar as estruturas.
+// Atômicos: o leitor de snapshots, a união paralela, a contagem por ids e
+// a leitura em trechos alocam de outras threads.
+static atomic<size_t> g_live_bytes(0);
+static atomic<size_t> g_allocs(0);
+
+void* operator new(size_t n) {
+    void* p = malloc(n ? n : 1);
+    if (!p) throw bad_alloc();
+    g_live_bytes.fetch_add(malloc_usable_size(p), memory_order_relaxed);
+    g_allocs.fetch_add(1, memory_order_relaxed);
+    return p;
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept {
+    if (!p) return;
+    g_live_bytes.fetch_sub(malloc_usable_size(p), memory_order_relaxed);
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    operator delete(p);
+}
+
+static volatile long long g_sink = 0;
+
+static void printHeader() {
+    cout << left << setw(22) << "estrutura"
+         << right << setw(10) << "chaves"
+         << setw(14) << "insercao(ms)"
+         << setw(14) << "busca(ns/op)"
+         << setw(14) << "memoria(KiB)"
+         << setw(12) << "bytes/chave" << '\n';
+}
+
+// Insere todas as palavras (insert-or-increment) e depois busca cada uma
+template <typename Dict>
+void benchDictionary(const string& name, const vector<string>& words) {
+    Timer t;
+    size_t before = g_live_bytes.load(memory_order_relaxed);
+    Dict* dict = new Dict();
+
+    t.begin();
+    for (const auto& w : words) dict->insert(w);
+    t.stop();
+    double insertMs = t.durationMs();
+    size_t bytes = g_live_bytes.load(memory_order_relaxed) - before;
+
+    long long sum = 0;
+    t.begin();
+    for (const auto& w : words) sum += dict->get(w);
+    t.stop();
+    g_sink += sum;
+    double lookupNs = t.durationMs() * 1e6 / words.size();
+
+    cout << left << setw(22) << name
+         << right << setw(10) << dict->size()
+         << setw(14) << fixed << setprecision(2) << insertMs
+         << setw(14) << setprecision(1) << lookupNs
+         << setw(14) << bytes / 1024
+         << setw(12) << setprecision(1) << double(bytes) / dict->size() << '\n';
+    delete dict;
+}
+
+// Latência individual de cada insert de chaves distintas, para expor o
+// custo concentrado do rehash
+static void benchRehashLatency(bool incremental, size_t n) {
+    ChainedHashTable<string, int> table;
+    table.set_incremental_rehash(incremental);
+    vector<string> keys;
+    keys.reserve(n);
+    for (size_t i = 0; i < n; i++) keys.push_back("chave" + to_string(i));
+
+    vector<double> lat;
+    lat.reserve(n);
+    auto start = chrono::steady_clock::now();
+    for (const auto& k : keys) {
+        auto t0 = chrono::steady_clock::now();
+        table.insert(k);
+        lat.push_back(chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count());
+    }
+    double totalMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    sort(lat.begin(), lat.end());
+    cout << left << setw(22) << (incremental ? "rehash incremental" : "rehash completo")
+         << right << fixed << setprecision(1)
+         << "  total " << setw(8) << totalMs << " ms"
+         << "  p50 " << setw(7) << lat[n / 2] << " ns"
+         << "  p99 " << setw(7) << lat[n * 99 / 100] << " ns"
+         << "  max " << setw(12) << lat.back() << " ns\n";
+}
+
+// Comprimento das cadeias e custo em bytes por entrada da tabela encadeada
+static void benchChains(const vector<string>& words) {
+    size_t before = g_live_bytes.load(memory_order_relaxed);
+    ChainedHashTable<string, int>* table = new ChainedHashTable<string, int>();
+    for (const auto& w : words) table->insert(w);
+    size_t bytes = g_live_bytes.load(memory_order_relaxed) - before;
+
+    size_t maxChain = 0, used = 0;
+    for (size_t i = 0; i < table->bucket_count(); i++) {
+        size_t len = table->bucket_size(i);
+        maxChain = max(maxChain, len);
+        if (len) used++;
+    }
+    cout << "ChainedHashTable: " << table->bucket_count() << " baldes, "
+         << "fator de carga " << setprecision(2) << table->load_factor()
+         << ", cadeia média (baldes ocupados) " << double(table->size()) / used
+         << ", cadeia máxima " << maxChain
+         << ", " << setprecision(1) << double(bytes) / table->size() << " bytes/entrada\n";
+    delete table;
+}
+
+// Custo do hash e qualidade da distribuição para cada política
+template <typename Hash>
+static void benchHash(const string& name, const vector<string>& words) {
+    ChainedHashTable<string, int, Hash> table;
+    Timer t;
+    t.begin();
+    for (const auto& w : words) table.insert(w);
+    t.stop();
+    double insertMs = t.durationMs();
+
+    long long sum = 0;
+    t.begin();
+    for (const auto& w : words) sum += table.get(w);
+    t.stop();
+    g_sink += sum;
+
+    HashDiagnostics d = table.diagnostics();
+    cout << left << setw(22) << name << right << fixed
+         << setw(14) << setprecision(2) << insertMs
+         << setw(14) << setprecision(1) << t.durationMs() * 1e6 / words.size()
+         << setw(10) << d.max_chain
+         << setw(12) << setprecision(3) << d.expected_probes
+         << setw(10) << d.actual_probes << '\n';
+}
+
+// Buscas uma a uma vs. get_batch sobre um dicionário grande e consultas
+// embaralhadas, onde cada busca sofre faltas de cache
+template <typename Dict>
+static void benchBatch(const string& name, const vector<string>& keys, const vector<string>& queries) {
+    Dict* dict = new Dict();
+    for (const auto& k : keys) dict->insert(k);
+
+    Timer t;
+    long long sum = 0;
+    t.begin();
+    for (const auto& q : queries) sum += dict->get(q);
+    t.stop();
+    double singleNs = t.durationMs() * 1e6 / queries.size();
+
+    vector<int> out(queries.size());
+    t.begin();
+    dict->get_batch(queries.data(), queries.size(), out.data());
+    t.stop();
+    double batchNs = t.durationMs() * 1e6 / queries.size();
+    for (int v : out) sum += v;
+    g_sink += sum;
+
+    cout << left << setw(22) << name << right << fixed << setprecision(1)
+         << setw(14) << singleNs << setw(14) << batchNs
+         << setw(10) << setprecision(2) << singleNs / batchNs << "x\n";
+    delete dict;
+}
+
+// Congela um dicionário já contado e compara a busca com a tabela original
+static void benchFrozen(const string& name, const vector<string>& keys, const vector<string>& queries) {
+    ChainedHashTable<string, int, WyHash> table;
+    for (const auto& k : keys) table.insert(k);
+
+    Timer t;
+    t.begin();
+    FrozenDictionary<string, int> frozen = freeze<string, int>(table);
+    t.stop();
+    double buildMs = t.durationMs();
+
+    long long sum = 0;
+    t.begin();
+    for (const auto& q : queries) sum += table.get(q);
+    t.stop();
+    double tableNs = t.durationMs() * 1e6 / queries.size();
+
+    t.begin();
+    for (const auto& q : queries) sum += frozen.get(q);
+    t.stop();
+    double frozenNs = t.durationMs() * 1e6 / queries.size();
+    g_sink += sum;
+
+    cout << left << setw(22) << name << right << fixed
+         << setw(10) << frozen.size()
+         << setw(14) << setprecision(2) << buildMs
+         << setw(12) << frozen.bits_per_key()
+         << setw(14) << setprecision(1) << tableNs
+         << setw(14) << frozenNs
+         << setw(12) << double(frozen.memory_usage()) / frozen.size() << '\n';
+}
+
+// Busca e rank depois da contagem: as árvores com nós espalhados no heap
+// contra a árvore implícita de Eytzinger exportada da AVL
+static void benchEytzinger(const string& name, const vector<string>& keys, const vector<string>& queries) {
+    AVL<string, int, true> avl;
+    RedBlackTree<string, int> rb;
+    for (const auto& k : keys) {
+        avl.insert(k);
+        rb.insert(k);
+    }
+
+    Timer t;
+    t.begin();
+    EytzingerDictionary<string, int> eytz = freezeOrdered<string, int>(avl);
+    t.stop();
+    double buildMs = t.durationMs();
+
+    auto perQuery = [&](auto&& lookup) {
+        long long sum = 0;
+        Timer q;
+        q.begin();
+        for (const auto& k : queries) sum += lookup(k);
+        q.stop();
+        g_sink += sum;
+        return q.durationMs() * 1e6 / queries.size();
+    };
+    double avlNs = perQuery([&](const string& k) { return avl.get(k); });
+    double rbNs = perQuery([&](const string& k) { return rb.get(k); });
+    double eytzNs = perQuery([&](const string& k) { return eytz.get(k); });
+    double avlRankNs = perQuery([&](const string& k) { return avl.rank(k); });
+    double eytzRankNs = perQuery([&](const string& k) { return eytz.rank(k); });
+
+    cout << left << setw(22) << name << right << fixed
+         << setw(10) << eytz.size()
+         << setw(14) << setprecision(2) << buildMs
+         << setw(12) << setprecision(1) << avlNs << setw(12) << rbNs << setw(12) << eytzNs
+         << setw(12) << avlRankNs << setw(12) << eytzRankNs
+         << setw(12) << double(eytz.memory_usage()) / eytz.size() << '\n';
+}
+
+// Um escritor conta o texto enquanto um leitor consulta a última versão
+// publicada; mede o custo da cópia de caminho para o escritor
+static void benchSnapshot(int publishInterval, const vector<string>& words) {
+    SnapshotRedBlackTree<string, int> tree;
+    tree.set_publish_interval(publishInterval);
+    atomic<bool> done(false);
+    long long reads = 0;
+    thread reader([&] {
+        size_t i = 0;
+        while (!done.load()) {
+            auto snap = tree.snapshot();
+            if (snap.contains(words[i])) g_sink += snap.get(words[i]);
+            i = (i + 7919) % words.size();
+            reads++;
+        }
+    });
+
+    Timer t;
+    t.begin();
+    for (const auto& w : words) tree.insert(w);
+    tree.publish();
+    t.stop();
+    done.store(true);
+    reader.join();
+
+    cout << left << setw(22) << ("publica a cada " + to_string(publishInterval)) << right << fixed
+         << setw(14) << setprecision(2) << t.durationMs()
+         << setw(14) << setprecision(1) << t.durationMs() * 1e6 / words.size()
+         << setw(14) << reads << '\n';
+}
+
+// Trabalho por operação no texto real: a árvore splay troca balanceamento
+// estrito por adaptação à frequência de acesso
+template <typename Dict>
+static void benchAdaptivity(const string& name, const vector<string>& words) {
+    Dict dict;
+    for (const auto& w : words) dict.insert(w);
+    StatsReport ins = dict.stats();
+    long long found = 0;
+    for (const auto& w : words) found += dict.contains(w);
+    g_sink += found;
+    StatsReport all = dict.stats();
+    double n = words.size();
+    cout << left << setw(22) << name << right << fixed << setprecision(2)
+         << setw(14) << ins.comparisons / n
+         << setw(14) << (ins.rotations + ins.recolorings) / n
+         << setw(14) << (all.comparisons - ins.comparisons) / n
+         << setw(14) << (all.rotations - ins.rotations) / n << '\n';
+}
+
+// Inserção do texto com o cache de chaves quentes na frente da árvore
+template <typename Tree>
+static void benchHotCache(const string& name, size_t sets, const vector<string>& words) {
+    Tree tree;
+    tree.set_hot_cache(sets);
+    Timer t;
+    t.begin();
+    for (const auto& w : words) tree.insert(w);
+    t.stop();
+    cout << left << setw(22) << name << right << setw(10) << sets << fixed
+         << setw(14) << setprecision(2) << t.durationMs()
+         << setw(14) << setprecision(1) << tree.hot_cache_stats().hit_rate() * 100 << '\n';
+}
+
+// Fusão de duas AVLs de n chaves cada (metade em comum): reinserção via
+// forEach contra union_with por split/join
+static void benchUnion(size_t n, unsigned threads) {
+    vector<string> keys;
+    for (size_t i = 0; i < n * 3 / 2; i++) keys.push_back("chave" + to_string(i));
+    shuffle(keys.begin(), keys.end(), mt19937(7));
+    auto build = [&](AVL<string, int>& a, AVL<string, int>& b) {
+        for (size_t i = 0; i < n; i++) a.insert(keys[i]);
+        for (size_t i = n / 2; i < n * 3 / 2; i++) b.insert(keys[i]);
+    };
+
+    AVL<string, int> a1, b1;
+    build(a1, b1);
+    Timer t;
+    t.begin();
+    b1.forEach([&](const string& key, int value) {
+        if (a1.contains(key)) a1.update(key, a1.get(key) + value);
+        else {
+            a1.insert(key);
+            if (value != 1) a1.update(key, value);
+        }
+    });
+    t.stop();
+    double reinsertMs = t.durationMs();
+
+    AVL<string, int> a2, b2;
+    build(a2, b2);
+    t.begin();
+    a2.union_with(b2, [](int x, int y) { return x + y; }, threads);
+    t.stop();
+
+    cout << left << setw(22) << (to_string(n) + " + " + to_string(n)) << right << fixed << setprecision(2)
+         << setw(14) << reinsertMs << setw(14) << t.durationMs() << setw(10) << threads
+         << setw(10) << setprecision(1) << reinsertMs / t.durationMs() << "x\n";
+}
+
+// Janela deslizante: custo por palavra (um incremento mais um decremento) e
+// alocações por palavra depois que a janela encheu, que deveriam ser zero
+template <typename Dict>
+static void benchWindow(const string& name, size_t windowWords, const vector<string>& words) {
+    Dict dict;
+    SlidingWindow<Dict> window(dict, windowWords);
+    size_t warm = min(words.size(), 2 * windowWords);
+    for (size_t i = 0; i < warm; i++) window.push(words[i]);
+
+    Timer t;
+    size_t allocs = g_allocs.load(memory_order_relaxed);
+    t.begin();
+    for (size_t i = warm; i < words.size(); i++) window.push(words[i]);
+    t.stop();
+    allocs = g_allocs.load(memory_order_relaxed) - allocs;
+    size_t n = words.size() - warm;
+    cout << left << setw(22) << name << right << fixed
+         << setw(14) << setprecision(1) << (n ? t.durationMs() * 1e6 / n : 0.0)
+         << setw(14) << setprecision(3) << (n ? double(allocs) / n : 0.0)
+         << setw(12) << dict.size() << '\n';
+}
+
+// Nova contagem do mesmo texto: strings num dicionário contra counts[id]++
+// sobre o corpus já codificado, com uma ou mais threads
+static void benchVocabulary(const vector<string>& words, unsigned threads) {
+    Timer t;
+    t.begin();
+    VocabularyBuilder<ChainedHashTable<string, int>> builder;
+    for (const auto& w : words) builder.add(w);
+    EncodedCorpus corpus = builder.release();
+    t.stop();
+    double encodeMs = t.durationMs();
+
+    t.begin();
+    ChainedHashTable<string, int> table;
+    for (const auto& w : words) table.insert(w);
+    t.stop();
+    double stringMs = t.durationMs();
+
+    // O melhor de algumas rodadas: a passada é curta demais para uma só
+    double idsMs = 1e300;
+    for (int round = 0; round < 5; round++) {
+        t.begin();
+        vector<uint64_t> counts = countIds(corpus.ids, corpus.words.size(), threads);
+        t.stop();
+        g_sink += counts[0];
+        idsMs = min(idsMs, t.durationMs());
+    }
+    cout << left << setw(22) << ("ids, " + to_string(threads) + " thread(s)") << right << fixed << setprecision(2)
+         << setw(14) << encodeMs << setw(14) << stringMs << setw(14) << idsMs
+         << setw(10) << setprecision(1) << stringMs / idsMs << "x\n";
+}
+
+// n-gramas do texto: a string concatenada de cada um numa tabela encadeada
+// contra os ids empacotados na tabela de endereçamento aberto
+template <unsigned N>
+static void benchNgram(const vector<string>& words) {
+    size_t before = g_live_bytes.load(memory_order_relaxed);
+    Timer t;
+    t.begin();
+    ChainedHashTable<string, int> strings;
+    string text;
+    for (size_t i = 0; i + N <= words.size(); i++) {
+        text = words[i];
+        for (unsigned j = 1; j < N; j++) {
+            text.push_back(' ');
+            text += words[i + j];
+        }
+        strings.insert(text);
+    }
+    t.stop();
+    double stringMs = t.durationMs();
+    size_t stringBytes = g_live_bytes.load(memory_order_relaxed) - before;
+
+    before = g_live_bytes.load(memory_order_relaxed);
+    t.begin();
+    NgramCounter<N, ChainedHashTable<string, int>> packed;
+    for (const auto& w : words) packed.push(w);
+    t.stop();
+    size_t packedBytes = g_live_bytes.load(memory_order_relaxed) - before;
+
+    cout << left << setw(22) << (to_string(N) + "-gramas") << right << setw(10) << packed.size() << fixed
+         << setprecision(2) << setw(14) << stringMs << setw(14) << t.durationMs()
+         << setw(14) << stringBytes / 1024 << setw(14) << packedBytes / 1024 << '\n';
+}
+
+// Leitura e separação das palavras do arquivo inteiro: o leitor sequencial
+// contra os trechos em paralelo, conferindo que a sequência é a mesma
+static void benchTokenize(const string& file, const vector<string>& expected, unsigned threads) {
+    double best = 1e300;
+    bool same = true;
+    for (int round = 0; round < 3; round++) {
+        Timer t;
+        t.begin();
+        vector<string> words = readAndProcessText(file, ReadOptions(), threads);
+        t.stop();
+        best = min(best, t.durationMs());
+        same = same && words == expected;
+    }
+    cout << left << setw(22) << (to_string(threads) + " thread(s)") << right << fixed << setprecision(2)
+         << setw(14) << best << setw(14) << setprecision(1) << expected.size() / best / 1000
+         << setw(12) << (same ? "sim" : "NÃO") << '\n';
+}
+
+// Reproduz o trace num dicionário novo, sem tokenização na medida; o melhor
+// de algumas rodadas, para reduzir o ruído
+template <typename Dict>
+static void benchReplay(const string& name, const Trace& trace) {
+    const int ROUNDS = 3;
+    double best = 0;
+    ReplayResult result;
+    for (int r = 0; r < ROUNDS; r++) {
+        Dict dict;
+        Timer t;
+        t.begin();
+        result = replayTrace(dict, trace);
+        t.stop();
+        if (r == 0 || t.durationMs() < best) best = t.durationMs();
+    }
+    cout << left << setw(22) << name << right << fixed
+         << setw(14) << setprecision(2) << best
+         << setw(14) << setprecision(1) << (trace.ops.empty() ? 0.0 : best * 1e6 / trace.ops.size())
+         << setw(16) << result.checksum << '\n';
+}
+
+static void replayAll(const string& traceFile) {
+    Trace trace = readTrace(traceFile);
+    ReplayResult counts;
+    for (const auto& e : trace.ops) counts.counts[static_cast<int>(e.op)]++;
+    cout << "Trace: " << traceFile << " (" << trace.ops.size() << " operações, " << trace.keys.size() << " chaves; "
+         << counts.counts[0] << " insert, " << counts.counts[1] << " get, "
+         << counts.counts[2] << " update, " << counts.counts[3] << " remove)\n\n";
+    cout << left << setw(22) << "estrutura" << right
+         << setw(14) << "total(ms)" << setw(14) << "ns/op" << setw(16) << "checksum" << '\n';
+    benchReplay<AVL<string, int>>("AVL", trace);
+    benchReplay<RedBlackTree<string, int>>("RedBlackTree", trace);
+    benchReplay<SplayTree<string, int>>("SplayTree", trace);
+    benchReplay<SplayTree<string, int, true>>("SplayTree (semi)", trace);
+    benchReplay<ChainedHashTable<string, int>>("ChainedHashTable", trace);
+    benchReplay<ART<string, int>>("ART", trace);
+    benchReplay<ConcurrentSkipList<string, int>>("ConcurrentSkipList", trace);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 2 && string(argv[1]) == "--replay") {
+        try {
+            replayAll(argv[2]);
+        }
+        catch (const exception& e) {
+            cerr << "Erro: " << e.what() << '\n';
+            return 1;
+        }
+        return 0;
+    }
+
+    string inputFile = argc > 1 ? argv[1] : "data/a_riqueza_das nacoes_english.txt";
+
+    try {
+        auto words = readAndProcessText(inputFile);
+        cout << "Arquivo: " << inputFile << " (" << words.size() << " palavras)\n\n";
+
+        printHeader();
+        benchDictionary<AVL<string, int>>("AVL", words);
+        benchDictionary<RedBlackTree<string, int>>("RedBlackTree", words);
+        benchDictionary<ChainedHashTable<string, int>>("ChainedHashTable", words);
+        benchDictionary<SplayTree<string, int>>("SplayTree", words);
+        benchDictionary<SplayTree<string, int, true>>("SplayTree (semi)", words);
+        benchDictionary<ART<string, int>>("ART", words);
+        benchDictionary<AVL<string, int, false, CountingStats>>("AVL+CountingStats", words);
+        benchDictionary<RedBlackTree<string, int, false, CountingStats>>("RBT+CountingStats", words);
+        benchDictionary<ChainedHashTable<string, int, StdHash, CountingStats>>("CHT+CountingStats", words);
+
+        cout << '\n' << left << setw(22) << "por palavra" << right
+             << setw(14) << "ins.comp" << setw(14) << "ins.reestr" << setw(14) << "busca.comp" << setw(14) << "busca.rot" << '\n';
+        benchAdaptivity<AVL<string, int, false, CountingStats>>("AVL", words);
+        benchAdaptivity<RedBlackTree<string, int, false, CountingStats>>("RedBlackTree", words);
+        benchAdaptivity<SplayTree<string, int, false, CountingStats>>("SplayTree", words);
+        benchAdaptivity<SplayTree<string, int, true, CountingStats>>("SplayTree (semi)", words);
+
+        cout << '\n' << left << setw(22) << "cache quente" << right
+             << setw(10) << "conjuntos" << setw(14) << "insercao(ms)" << setw(14) << "acertos(%)" << '\n';
+        for (size_t sets : {0, 64, 256, 1024}) benchHotCache<AVL<string, int>>("AVL", sets, words);
+        for (size_t sets : {0, 64, 256, 1024}) benchHotCache<RedBlackTree<string, int>>("RedBlackTree", sets, words);
+
+        // @consulta por prefixo, exclusiva da ART
+        ART<string, int> art;
+        for (const auto& w : words) art.insert(w);
+        Timer t;
+        int matches = 0, total = 0;
+        t.begin();
+        art.prefix_scan("econom", [&](const string&, const int& v) {
+            matches++;
+            total += v;
+        });
+        t.stop();
+        cout << "\nART prefix_scan(\"econom\"): " << matches << " chaves, "
+             << total << " ocorrências em " << t.durationMs() * 1000 << " us\n";
+
+        cout << '\n';
+        benchChains(words);
+
+        cout << '\n' << left << setw(22) << "hash" << right
+             << setw(14) << "insercao(ms)" << setw(14) << "busca(ns/op)"
+             << setw(10) << "max" << setw(12) << "sond.esp" << setw(10) << "sond.real" << '\n';
+        benchHash<StdHash>("std::hash", words);
+        benchHash<FnvHash>("FnvHash", words);
+        benchHash<WyHash>("WyHash", words);
+        benchHash<Xxh3Hash>("Xxh3Hash", words);
+        benchHash<ShortWordHash>("ShortWordHash", words);
+
+        {
+            vector<string> keys;
+            for (int i = 0; i < 1000000; i++) keys.push_back("chave" + to_string(i));
+            vector<string> queries(keys);
+            shuffle(queries.begin(), queries.end(), mt19937(42));
+            cout << '\n' << left << setw(22) << "1M chaves, lote" << right
+                 << setw(14) << "get(ns/op)" << setw(14) << "lote(ns/op)" << setw(11) << "ganho" << '\n';
+            benchBatch<AVL<string, int>>("AVL", keys, queries);
+            benchBatch<RedBlackTree<string, int>>("RedBlackTree", keys, queries);
+            benchBatch<ChainedHashTable<string, int>>("ChainedHashTable", keys, queries);
+        }
+
+        {
+            vector<string> keys;
+            for (int i = 0; i < 1000000; i++) keys.push_back("chave" + to_string(i));
+            vector<string> queries(keys);
+            shuffle(queries.begin(), queries.end(), mt19937(42));
+            cout << '\n' << left << setw(22) << "congelado" << right
+                 << setw(10) << "chaves" << setw(14) << "constr.(ms)" << setw(12) << "bits/chave"
+                 << setw(14) << "tabela(ns)" << setw(14) << "congel.(ns)" << setw(12) << "bytes/chave" << '\n';
+            benchFrozen("texto", words, words);
+            benchFrozen("1M chaves", keys, queries);
+        }
+
+        {
+            vector<string> keys;
+            for (int i = 0; i < 1000000; i++) keys.push_back("chave" + to_string(i));
+            vector<string> queries(keys);
+            shuffle(queries.begin(), queries.end(), mt19937(42));
+            cout << '\n' << left << setw(22) << "Eytzinger" << right
+                 << setw(10) << "chaves" << setw(14) << "constr.(ms)" << setw(12) << "AVL(ns)" << setw(12) << "RB(ns)"
+                 << setw(12) << "Eytz.(ns)" << setw(12) << "rankAVL" << setw(12) << "rankEytz." << setw(12) << "bytes/chave" << '\n';
+            benchEytzinger("texto", words, words);
+            benchEytzinger("1M chaves", keys, queries);
+        }
+
+        cout << '\n' << left << setw(22) << "RB com snapshots" << right
+             << setw(14) << "escrita(ms)" << setw(14) << "insert(ns)" << setw(14) << "leituras" << '\n';
+        {
+            RedBlackTree<string, int> plain;
+            Timer t;
+            t.begin();
+            for (const auto& w : words) plain.insert(w);
+            t.stop();
+            cout << left << setw(22) << "RedBlackTree (sem)" << right << fixed
+                 << setw(14) << setprecision(2) << t.durationMs()
+                 << setw(14) << setprecision(1) << t.durationMs() * 1e6 / words.size() << '\n';
+        }
+        benchSnapshot(1, words);
+        benchSnapshot(64, words);
+
+        cout << '\n' << left << setw(22) << "união de AVLs" << right
+             << setw(14) << "forEach(ms)" << setw(14) << "union(ms)" << setw(10) << "threads" << setw(11) << "ganho" << '\n';
+        unsigned hw = max(1u, thread::hardware_concurrency());
+        benchUnion(10000, 1);
+        benchUnion(500000, 1);
+        if (hw > 1) benchUnion(500000, hw);
+
+        const size_t WINDOW = 10000;
+        cout << '\n' << left << setw(22) << "janela de 10000" << right
+             << setw(14) << "ns/palavra" << setw(14) << "aloc/palavra" << setw(12) << "distintas" << '\n';
+        benchWindow<AVL<string, int>>("AVL", WINDOW, words);
+        benchWindow<RedBlackTree<string, int>>("RedBlackTree", WINDOW, words);
+        benchWindow<SplayTree<string, int>>("SplayTree", WINDOW, words);
+        benchWindow<ChainedHashTable<string, int>>("ChainedHashTable", WINDOW, words);
+
+        cout << '\n' << left << setw(22) << "vocabulário" << right << setw(14) << "codif.(ms)"
+             << setw(14) << "strings(ms)" << setw(14) << "ids(ms)" << setw(11) << "ganho" << '\n';
+        benchVocabulary(words, 1);
+        if (hw > 1) benchVocabulary(words, hw);
+
+        cout << '\n' << left << setw(22) << "n-gramas" << right << setw(10) << "distintos"
+             << setw(14) << "strings(ms)" << setw(14) << "ids(ms)" << setw(14) << "strings(KiB)" << setw(14) << "ids(KiB)" << '\n';
+        benchNgram<2>(words);
+        benchNgram<3>(words);
+
+        cout << '\n' << left << setw(22) << "leitura" << right << setw(14) << "ms"
+             << setw(14) << "Mpalavras/s" << setw(12) << "idêntica" << '\n';
+        for (unsigned n : {1u, 2u, 4u, 8u}) benchTokenize(inputFile, words, n);
+        if (hw > 8) benchTokenize(inputFile, words, hw);
+
+        cout << "\nChainedHashTable, 1M inserts de chaves distintas:\n";
+        benchRehashLatency(false, 1000000);
+        benchRehashLatency(true, 1000000);
+    }
+    catch (const exception& e) {
+        cerr << "Erro: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
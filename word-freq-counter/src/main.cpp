@@ -1,30 +1,651 @@
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <string>
+#include <vector>
+#include <thread>
+#include <memory>
+#include <iomanip>
+#include <algorithm>
 #include "../include/AVL.hpp"
 #include "../include/RedBlackTree.hpp"
+#include "../include/SplayTree.hpp"
+#include "../include/ART.hpp"
+#include "../include/ChainedHashTable.hpp"
+#include "../include/ConcurrentSkipList.hpp"
+#include "../include/HashFunctions.hpp"
 #include "../include/TextProcessor.hpp"
+#include "../include/BatchJob.hpp"
+#include "../include/WorkStealingPool.hpp"
+#include "../include/SlidingWindow.hpp"
+#include "../include/Trace.hpp"
+#include "../include/SpillMerge.hpp"
+#include "../include/Vocabulary.hpp"
+#include "../include/Ngram.hpp"
 #include "../include/Utils.hpp"
 
 using namespace std;
 
+// Contadores e logs das estruturas só nas compilações de pesquisa (make STATS=1)
+#ifdef FREQ_STATS
+using DictStats = CountingStats;
+#else
+using DictStats = NoStats;
+#endif
+
+// Grava apenas as chaves em [lo, hi], sem percorrer a árvore inteira
+template <typename Tree>
+void printRange(const Tree& tree, const string& lo, const string& hi, ostream& out) {
+    for (const auto& node : tree.range(lo, hi)) {
+        out << node.key << " : " << node.value << '\n';
+    }
+}
+
+// Conta as palavras numa tabela encadeada com a política de hash escolhida
+template <typename Hash>
+void runHashTable(const vector<string>& words, ostream& out, bool showStats) {
+    ChainedHashTable<string, int, Hash, DictStats> table;
+    for (const auto& word : words) {
+        table.insert(word);
+    }
+    table.forEach([&](const string& key, const int& value) {
+        out << key << " : " << value << '\n';
+    });
+    if (showStats) table.diagnostics().print(cout);
+    if (DictStats::enabled) table.stats().print(cout);
+}
+
+// Seleciona a política de hash pelo nome dado em --hash
+bool runHashTable(const string& hashName, const vector<string>& words, ostream& out, bool showStats) {
+    if (hashName == "std") runHashTable<StdHash>(words, out, showStats);
+    else if (hashName == "fnv") runHashTable<FnvHash>(words, out, showStats);
+    else if (hashName == "wy") runHashTable<WyHash>(words, out, showStats);
+    else if (hashName == "xxh3") runHashTable<Xxh3Hash>(words, out, showStats);
+    else if (hashName == "short") runHashTable<ShortWordHash>(words, out, showStats);
+    else return false;
+    return true;
+}
+
+// Cada thread conta uma fatia das palavras direto na mesma lista de saltos;
+// como ela já é ordenada, o resultado sai em ordem alfabética sem fusão
+void runSkipList(const vector<string>& words, unsigned threads, ostream& out) {
+    ConcurrentSkipList<string, int> list;
+    vector<thread> workers;
+    size_t slice = (words.size() + threads - 1) / threads;
+    for (unsigned i = 0; i < threads; i++) {
+        size_t from = min(words.size(), i * slice), to = min(words.size(), from + slice);
+        workers.emplace_back([&, from, to] {
+            for (size_t j = from; j < to; j++) list.insert(words[j]);
+        });
+    }
+    for (auto& w : workers) w.join();
+    list.print(out);
+}
+
+// Soma uma contagem vinda de outro dicionário
+template <typename Dict>
+void mergeCount(Dict& dict, const string& key, int count) {
+    if (dict.contains(key)) {
+        dict.update(key, dict.get(key) + count);
+    } else {
+        dict.insert(key);
+        if (count != 1) dict.update(key, count);
+    }
+}
+
+// Soma todas as contagens de part em total
+template <typename Dict>
+void mergeInto(Dict& total, Dict& part, unsigned) {
+    part.forEach([&](const string& key, int value) {
+        mergeCount(total, key, value);
+    });
+}
+
+// A AVL une as árvores por split/join, movendo os nós sem reinserir
+template <typename Key, typename Value, bool OrderStatistics, typename Stats>
+void mergeInto(AVL<Key, Value, OrderStatistics, Stats>& total, AVL<Key, Value, OrderStatistics, Stats>& part,
+               unsigned threads) {
+    total.union_with(part, [](const Value& a, const Value& b) { return a + b; }, threads);
+}
+
+// Lote de arquivos: o pool conta cada tarefa no dicionário da thread que a
+// executa; no fim os dicionários das threads são somados num só
+template <typename Dict>
+void runBatch(const vector<string>& files, unsigned threads, const ReadOptions& options, ostream& out) {
+    const uint64_t CHUNK_BYTES = 8 << 20;
+    struct FileStats {
+        size_t words = 0;
+        double ms = 0;
+    };
+
+    Timer wall, merge;
+    wall.begin();
+    auto tasks = planBatch(files, CHUNK_BYTES);
+    WorkStealingPool pool(threads);
+    vector<unique_ptr<Dict>> dicts;
+    for (unsigned i = 0; i < pool.workers(); i++) dicts.emplace_back(new Dict());
+    vector<vector<FileStats>> stats(pool.workers(), vector<FileStats>(files.size()));
+
+    for (const auto& task : tasks) {
+        pool.submit([&, task](unsigned worker) {
+            Dict& dict = *dicts[worker];
+            for (const auto& piece : task.pieces) {
+                Timer t;
+                size_t n = 0;
+                t.begin();
+                forEachWord(files[piece.file], [&](const string& word) {
+                    dict.insert(word);
+                    n++;
+                }, options, piece.begin, piece.end);
+                t.stop();
+                stats[worker][piece.file].words += n;
+                stats[worker][piece.file].ms += t.durationMs();
+            }
+        });
+    }
+    pool.run();
+
+    merge.begin();
+    Dict& total = *dicts[0];
+    for (size_t i = 1; i < dicts.size(); i++) {
+        mergeInto(total, *dicts[i], threads);
+        dicts[i].reset();
+    }
+    merge.stop();
+
+    total.forEach([&](const string& key, int value) {
+        out << key << " : " << value << '\n';
+    });
+    wall.stop();
+
+    size_t totalWords = 0;
+    cout << left << setw(48) << "arquivo" << right << setw(12) << "palavras" << setw(12) << "ms" << '\n';
+    for (size_t f = 0; f < files.size(); f++) {
+        FileStats sum;
+        for (const auto& s : stats) {
+            sum.words += s[f].words;
+            sum.ms += s[f].ms;
+        }
+        totalWords += sum.words;
+        cout << left << setw(48) << files[f] << right << setw(12) << sum.words
+             << setw(12) << fixed << setprecision(2) << sum.ms << '\n';
+    }
+    cout << files.size() << " arquivos, " << tasks.size() << " tarefas, " << pool.steals() << " roubos, "
+         << pool.workers() << " threads\n"
+         << totalWords << " palavras, " << total.size() << " distintas; "
+         << "total " << wall.durationMs() << " ms, fusão " << merge.durationMs() << " ms\n";
+}
+
+// Seleciona o dicionário do lote pelo tipo dado na linha de comando
+bool runBatch(const string& dictType, const vector<string>& files, unsigned threads,
+              const ReadOptions& options, ostream& out) {
+    if (dictType == "dictionary_avl") runBatch<AVL<string, int>>(files, threads, options, out);
+    else if (dictType == "dictionary_rb") runBatch<RedBlackTree<string, int>>(files, threads, options, out);
+    else if (dictType == "dictionary_splay") runBatch<SplayTree<string, int>>(files, threads, options, out);
+    else if (dictType == "dictionary_semisplay") runBatch<SplayTree<string, int, true>>(files, threads, options, out);
+    else if (dictType == "dictionary_art") runBatch<ART<string, int>>(files, threads, options, out);
+    else if (dictType == "dictionary_hash") runBatch<ChainedHashTable<string, int>>(files, threads, options, out);
+    else if (dictType == "dictionary_skiplist") runBatch<ConcurrentSkipList<string, int>>(files, threads, options, out);
+    else return false;
+    return true;
+}
+
+// Janela deslizante: as entradas são lidas em sequência e no fim o
+// dicionário guarda só as contagens das últimas palavras
+template <typename Dict>
+void runWindow(const vector<string>& files, size_t maxWords, size_t maxBytes,
+               const ReadOptions& options, ostream& out) {
+    Dict dict;
+    SlidingWindow<Dict> window(dict, maxWords, maxBytes);
+    size_t n = 0;
+    for (const auto& file : files) {
+        forEachWord(file, [&](const string& word) {
+            window.push(word);
+            n++;
+        }, options);
+    }
+    dict.forEach([&](const string& key, int value) {
+        out << key << " : " << value << '\n';
+    });
+    cout << n << " palavras lidas, " << window.words() << " na janela ("
+         << window.bytes() << " bytes), " << dict.size() << " distintas, "
+         << window.evictions() << " chaves expiradas\n";
+    if (DictStats::enabled) dict.stats().print(cout);
+}
+
+// Seleciona o dicionário da janela; só os que sabem decrementar
+bool runWindow(const string& dictType, const vector<string>& files, size_t maxWords, size_t maxBytes,
+               const ReadOptions& options, ostream& out) {
+    if (dictType == "dictionary_avl") runWindow<AVL<string, int, false, DictStats>>(files, maxWords, maxBytes, options, out);
+    else if (dictType == "dictionary_rb") runWindow<RedBlackTree<string, int, false, DictStats>>(files, maxWords, maxBytes, options, out);
+    else if (dictType == "dictionary_splay") runWindow<SplayTree<string, int, false, DictStats>>(files, maxWords, maxBytes, options, out);
+    else if (dictType == "dictionary_semisplay") runWindow<SplayTree<string, int, true, DictStats>>(files, maxWords, maxBytes, options, out);
+    else if (dictType == "dictionary_hash") runWindow<ChainedHashTable<string, int, std::hash<string>, DictStats>>(files, maxWords, maxBytes, options, out);
+    else return false;
+    return true;
+}
+
+// Memória externa: as entradas são lidas em sequência e, quando a estimativa
+// de memória do dicionário passa do limite, ele é despejado como uma run
+// ordenada e esvaziado. No fim as runs são fundidas com as contagens exatas.
+template <typename Dict>
+void runExternal(const vector<string>& files, uint64_t memoryLimit, const string& tempDir,
+                 const ReadOptions& options, ostream& out) {
+    // Estimativa por chave distinta: nó, string e folga do alocador
+    const uint64_t KEY_OVERHEAD = 64;
+
+    SpillSet spills(tempDir);
+    unique_ptr<Dict> dict(new Dict());
+    uint64_t used = 0;
+    size_t words = 0;
+    auto spill = [&] {
+        vector<pair<const string*, int>> entries;
+        entries.reserve(dict->size());
+        dict->forEach([&](const string& key, const int& value) {
+            entries.emplace_back(&key, value);
+        });
+        spills.spill(entries);
+        dict.reset(new Dict());
+        used = 0;
+    };
+
+    for (const auto& file : files) {
+        forEachWord(file, [&](const string& word) {
+            size_t before = dict->size();
+            dict->insert(word);
+            words++;
+            if (size_t(dict->size()) != before) {
+                used += KEY_OVERHEAD + word.size();
+                if (used >= memoryLimit) spill();
+            }
+        }, options);
+    }
+
+    size_t distinct = 0;
+    if (spills.runs() == 0) {
+        dict->forEach([&](const string& key, int value) {
+            out << key << " : " << value << '\n';
+            distinct++;
+        });
+    } else {
+        if (dict->size() > 0) spill();
+        dict.reset();
+        spills.merge([&](const string& key, int64_t value) {
+            out << key << " : " << value << '\n';
+            distinct++;
+        });
+    }
+
+    const SpillStats& s = spills.stats();
+    cout << words << " palavras, " << distinct << " distintas; limite " << memoryLimit / 1024 << " KiB\n"
+         << s.runs << " runs, " << s.passes << " passadas intermediárias; gravados "
+         << s.bytes_written / 1024 << " KiB, lidos " << s.bytes_read / 1024 << " KiB\n"
+         << "despejo " << s.spill_ms << " ms, fusão " << s.merge_ms << " ms\n";
+}
+
+bool runExternal(const string& dictType, const vector<string>& files, uint64_t memoryLimit,
+                 const string& tempDir, const ReadOptions& options, ostream& out) {
+    if (dictType == "dictionary_avl") runExternal<AVL<string, int>>(files, memoryLimit, tempDir, options, out);
+    else if (dictType == "dictionary_rb") runExternal<RedBlackTree<string, int>>(files, memoryLimit, tempDir, options, out);
+    else if (dictType == "dictionary_splay") runExternal<SplayTree<string, int>>(files, memoryLimit, tempDir, options, out);
+    else if (dictType == "dictionary_semisplay") runExternal<SplayTree<string, int, true>>(files, memoryLimit, tempDir, options, out);
+    else if (dictType == "dictionary_art") runExternal<ART<string, int>>(files, memoryLimit, tempDir, options, out);
+    else if (dictType == "dictionary_hash") runExternal<ChainedHashTable<string, int>>(files, memoryLimit, tempDir, options, out);
+    else if (dictType == "dictionary_skiplist") runExternal<ConcurrentSkipList<string, int>>(files, memoryLimit, tempDir, options, out);
+    else return false;
+    return true;
+}
+
+// Codifica as entradas em sequência: Dict monta o vocabulário e o texto
+// vira a sequência de ids, gravada em idsFile para as próximas contagens
+template <typename Dict>
+EncodedCorpus runEncode(const vector<string>& files, const string& idsFile, const ReadOptions& options) {
+    Timer t;
+    t.begin();
+    VocabularyBuilder<Dict> builder;
+    for (const auto& file : files) {
+        forEachWord(file, [&](const string& word) { builder.add(word); }, options);
+    }
+    EncodedCorpus corpus = builder.release();
+    writeCorpus(idsFile, corpus);
+    t.stop();
+    cout << "Corpus codificado em '" << idsFile << "': " << corpus.ids.size() << " ids, "
+         << corpus.words.size() << " palavras no vocabulário, " << t.durationMs() << " ms\n";
+    return corpus;
+}
+
+bool runEncode(const string& dictType, const vector<string>& files, const string& idsFile,
+               const ReadOptions& options, EncodedCorpus& corpus) {
+    if (dictType == "dictionary_avl") corpus = runEncode<AVL<string, int>>(files, idsFile, options);
+    else if (dictType == "dictionary_rb") corpus = runEncode<RedBlackTree<string, int>>(files, idsFile, options);
+    else if (dictType == "dictionary_splay") corpus = runEncode<SplayTree<string, int>>(files, idsFile, options);
+    else if (dictType == "dictionary_semisplay") corpus = runEncode<SplayTree<string, int, true>>(files, idsFile, options);
+    else if (dictType == "dictionary_art") corpus = runEncode<ART<string, int>>(files, idsFile, options);
+    else if (dictType == "dictionary_hash") corpus = runEncode<ChainedHashTable<string, int>>(files, idsFile, options);
+    else if (dictType == "dictionary_skiplist") corpus = runEncode<ConcurrentSkipList<string, int>>(files, idsFile, options);
+    else return false;
+    return true;
+}
+
+// Contagem sobre o corpus codificado: counts[id]++ por thread e redução
+// dos vetores; a saída sai em ordem alfabética, como nas árvores
+void writeIdCounts(const EncodedCorpus& corpus, unsigned threads, ostream& out) {
+    Timer t;
+    t.begin();
+    vector<uint64_t> counts = countIds(corpus.ids, corpus.words.size(), threads);
+    t.stop();
+    vector<uint32_t> order(corpus.words.size());
+    for (uint32_t i = 0; i < order.size(); i++) order[i] = i;
+    sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return corpus.words[a] < corpus.words[b]; });
+    for (uint32_t id : order) {
+        if (counts[id] > 0) out << corpus.words[id] << " : " << counts[id] << '\n';
+    }
+    cout << corpus.ids.size() << " ids contados em " << t.durationMs() << " ms ("
+         << threads << " threads)\n";
+}
+
+// n-gramas das entradas, cada arquivo uma sequência própria; a saída sai
+// em ordem alfabética do texto do n-grama
+template <unsigned N, typename Dict>
+void runNgram(const vector<string>& files, const ReadOptions& options, ostream& out) {
+    Timer t;
+    t.begin();
+    NgramCounter<N, Dict> counter;
+    for (const auto& file : files) {
+        forEachWord(file, [&](const string& word) { counter.push(word); }, options);
+        counter.reset();
+    }
+    t.stop();
+
+    vector<pair<string, int>> grams;
+    grams.reserve(counter.size());
+    counter.forEach([&](const string& text, int count) { grams.emplace_back(text, count); });
+    sort(grams.begin(), grams.end());
+    for (const auto& g : grams) out << g.first << " : " << g.second << '\n';
+
+    const auto& table = counter.table();
+    cout << counter.total() << " " << N << "-gramas, " << counter.size() << " distintos, "
+         << counter.vocabulary() << " palavras no vocabulário; contagem " << t.durationMs() << " ms\n"
+         << "tabela: " << table.capacity() << " slots, fator de carga " << table.load_factor()
+         << ", sondagem máxima " << table.max_probe() << '\n';
+}
+
+template <typename Dict>
+bool runNgram(unsigned n, const vector<string>& files, const ReadOptions& options, ostream& out) {
+    switch (n) {
+    case 1: runNgram<1, Dict>(files, options, out); return true;
+    case 2: runNgram<2, Dict>(files, options, out); return true;
+    case 3: runNgram<3, Dict>(files, options, out); return true;
+    case 4: runNgram<4, Dict>(files, options, out); return true;
+    }
+    throw invalid_argument("--ngram aceita de 1 a 4 palavras");
+}
+
+// O tipo de dicionário só interna as palavras; as contagens ficam sempre
+// na tabela de chaves inteiras
+bool runNgram(const string& dictType, unsigned n, const vector<string>& files,
+              const ReadOptions& options, ostream& out) {
+    if (dictType == "dictionary_avl") return runNgram<AVL<string, int>>(n, files, options, out);
+    if (dictType == "dictionary_rb") return runNgram<RedBlackTree<string, int>>(n, files, options, out);
+    if (dictType == "dictionary_splay") return runNgram<SplayTree<string, int>>(n, files, options, out);
+    if (dictType == "dictionary_semisplay") return runNgram<SplayTree<string, int, true>>(n, files, options, out);
+    if (dictType == "dictionary_art") return runNgram<ART<string, int>>(n, files, options, out);
+    if (dictType == "dictionary_hash") return runNgram<ChainedHashTable<string, int>>(n, files, options, out);
+    if (dictType == "dictionary_skiplist") return runNgram<ConcurrentSkipList<string, int>>(n, files, options, out);
+    return false;
+}
+
+// Tamanho com sufixo opcional K, M ou G (potências de 1024)
+uint64_t parseSize(const string& text) {
+    size_t end = 0;
+    uint64_t n = stoull(text, &end);
+    string suffix = text.substr(end);
+    if (suffix == "K" || suffix == "k") n <<= 10;
+    else if (suffix == "M" || suffix == "m") n <<= 20;
+    else if (suffix == "G" || suffix == "g") n <<= 30;
+    else if (!suffix.empty()) throw invalid_argument("Tamanho inválido: " + text);
+    return n;
+}
+
+// Grava as inserções da contagem como trace, opcionalmente misturadas com
+// leituras, atualizações e remoções sintéticas (--mix get:update:remove em %)
+void recordTrace(const vector<string>& words, const string& traceFile, const string& mix) {
+    TraceRecorder recorder;
+    for (const auto& word : words) recorder.insert(word);
+    Trace trace = recorder.release();
+    if (!mix.empty()) {
+        TraceMix m;
+        char sep1 = 0, sep2 = 0;
+        istringstream in(mix);
+        if (!(in >> m.get >> sep1 >> m.update >> sep2 >> m.remove) || sep1 != ':' || sep2 != ':') {
+            throw invalid_argument("--mix espera get:update:remove em %, ex.: 80:5:5");
+        }
+        m.get /= 100;
+        m.update /= 100;
+        m.remove /= 100;
+        trace = synthesizeTrace(trace, m);
+    }
+    writeTrace(traceFile, trace);
+    cout << "Trace gravado em '" << traceFile << "': " << trace.ops.size() << " operações, "
+         << trace.keys.size() << " chaves\n";
+}
+
 int main(int argc, char* argv[]) {
     // @declarando o timer
     Timer t;
 
+    // @separando opções e argumentos posicionais
+    vector<string> args;
+    bool hasRange = false;
+    string rangeLo, rangeHi;
+    string hashName = "std";
+    bool hashStats = false;
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    ReadOptions readOptions;
+    size_t windowWords = 0, windowBytes = 0;
+    string traceFile, traceMix;
+    uint64_t memoryLimit = 0;
+    size_t hotCacheSets = 0;
+    string tempDir;
+    string encodeFile, idsFile;
+    unsigned ngram = 0;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--range" && i + 2 < argc) {
+            hasRange = true;
+            rangeLo = argv[++i];
+            rangeHi = argv[++i];
+        } else if (arg == "--hash" && i + 1 < argc) {
+            hashName = argv[++i];
+        } else if (arg == "--hash-stats") {
+            hashStats = true;
+        } else if (arg == "--direct-io") {
+            readOptions.direct_io = true;
+        } else if (arg == "--window" && i + 1 < argc) {
+            windowWords = stoull(argv[++i]);
+        } else if (arg == "--window-bytes" && i + 1 < argc) {
+            windowBytes = stoull(argv[++i]);
+        } else if (arg == "--record" && i + 1 < argc) {
+            traceFile = argv[++i];
+        } else if (arg == "--mix" && i + 1 < argc) {
+            traceMix = argv[++i];
+        } else if (arg == "--hot-cache" && i + 1 < argc) {
+            hotCacheSets = stoull(argv[++i]);
+        } else if (arg == "--memory-limit" && i + 1 < argc) {
+            memoryLimit = parseSize(argv[++i]);
+        } else if (arg == "--temp-dir" && i + 1 < argc) {
+            tempDir = argv[++i];
+        } else if (arg == "--encode" && i + 1 < argc) {
+            encodeFile = argv[++i];
+        } else if (arg == "--ids" && i + 1 < argc) {
+            idsFile = argv[++i];
+        } else if (arg == "--ngram" && i + 1 < argc) {
+            ngram = stoul(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = max(1, stoi(argv[++i]));
+        } else {
+            args.push_back(arg);
+        }
+    }
+
+    // O trace só é gravado na contagem de um único arquivo; nos outros
+    // modos a opção seria ignorada em silêncio
+    if (!traceMix.empty() && traceFile.empty()) {
+        cerr << "--mix exige --record\n";
+        return 1;
+    }
+    if (!traceFile.empty() && (!idsFile.empty() || !encodeFile.empty() || ngram > 0 ||
+                               windowWords > 0 || windowBytes > 0 || memoryLimit > 0)) {
+        cerr << "--record só funciona na contagem de um único arquivo, sem --window, "
+                "--window-bytes, --memory-limit, --ngram, --encode ou --ids\n";
+        return 1;
+    }
+
+    // @contagem direta de um corpus já codificado: só a saída como argumento
+    if (!idsFile.empty() && args.size() == 1) {
+        try {
+            EncodedCorpus corpus = readCorpus(idsFile);
+            ofstream out(args[0]);
+            if (!out) {
+                cerr << "Erro ao abrir arquivo de saída: " << args[0] << '\n';
+                return 1;
+            }
+            out << "{Dicionário}\n";
+            writeIdCounts(corpus, threads, out);
+            cout << "Resultados gravados em '" << args[0] << "' com sucesso.\n";
+        }
+        catch (const exception& e) {
+            cerr << "Erro: " << e.what() << '\n';
+            return 1;
+        }
+        return 0;
+    }
+
     // @nomeando argumentos
-    if (argc < 4) {
-        cerr << "Uso: " << argv[0] << " <dictionary_avl|dictionary_rb> <entrada.txt> <saida.txt>\n";
+    if (args.size() < 3) {
+        cerr << "Uso: " << argv[0] << " [opções] <dictionary_avl|dictionary_rb|dictionary_splay|dictionary_semisplay|dictionary_art|dictionary_hash|dictionary_skiplist> <entrada...> <saida.txt>\n"
+             << "  várias entradas, diretórios ou padrões glob são contados em lote\n"
+             << "  --range <de> <até>   grava só as chaves no intervalo (avl, rb)\n"
+             << "  --hash <nome>        std, fnv, wy, xxh3 ou short (hash)\n"
+             << "  --hash-stats         mostra a distribuição dos baldes (hash)\n"
+             << "  --threads <n>        threads que leem e contam em paralelo (leitura, skiplist, lote, ids)\n"
+             << "  --direct-io          lê a entrada com O_DIRECT, sem passar pelo cache\n"
+             << "  --window <n>         conta só as últimas n palavras (avl, rb, splay, hash)\n"
+             << "  --window-bytes <t>   conta só as palavras dos últimos t bytes (avl, rb, splay, hash)\n"
+             << "  --record <trace>     grava as operações num trace para ./bench --replay (um arquivo só)\n"
+             << "  --mix <g:u:r>        com --record, % de leituras, atualizações e remoções\n"
+             << "  --hot-cache <n>      cache de n conjuntos para as palavras frequentes (avl, rb)\n"
+             << "  --memory-limit <n>   despeja runs ordenadas em disco ao passar de n bytes (K, M, G)\n"
+             << "  --temp-dir <dir>     onde gravar as runs (padrão: diretório temporário do sistema)\n"
+             << "  --encode <ids>       grava o vocabulário e o texto como ids densos e conta por eles\n"
+             << "  --ids <ids> <saida>  conta um corpus gravado com --encode, sem tipo nem entrada\n"
+             << "  --ngram <n>          conta sequências de n palavras (1 a 4); o dicionário só interna as palavras\n";
         return 1;
     }
 
-    string dictType = argv[1];
-    string inputFile = argv[2];
-    string outputFile = argv[3];
+    string dictType = args[0];
+    vector<string> inputs(args.begin() + 1, args.end() - 1);
+    string inputFile = inputs[0];
+    string outputFile = args.back();
 
     try {
+        // @várias entradas, diretório ou glob: modo lote
+        vector<string> files = expandInputs(inputs);
+        if (!traceFile.empty() && (files.size() != 1 || files[0] != inputFile)) {
+            cerr << "--record só funciona na contagem de um único arquivo\n";
+            return 1;
+        }
+
+        // @janela deslizante sobre as entradas em sequência
+        if (windowWords > 0 || windowBytes > 0) {
+            ofstream out(outputFile);
+            if (!out) {
+                cerr << "Erro ao abrir arquivo de saída: " << outputFile << '\n';
+                return 1;
+            }
+            out << "{Dicionário}\n";
+            t.begin();
+            if (!runWindow(dictType, files, windowWords, windowBytes, readOptions, out)) {
+                cerr << "Janela não suportada para o tipo: " << dictType << '\n';
+                return 1;
+            }
+            t.stop();
+            cout << "Resultados gravados em '" << outputFile << "' com sucesso.\n"
+                 << "Duração da execução: " << t.durationMs() << endl;
+            return 0;
+        }
+
+        // @memória externa: runs ordenadas em disco e fusão no fim
+        if (memoryLimit > 0) {
+            ofstream out(outputFile);
+            if (!out) {
+                cerr << "Erro ao abrir arquivo de saída: " << outputFile << '\n';
+                return 1;
+            }
+            out << "{Dicionário}\n";
+            t.begin();
+            if (!runExternal(dictType, files, memoryLimit, tempDir, readOptions, out)) {
+                cerr << "Tipo de dicionário inválido: " << dictType << '\n';
+                return 1;
+            }
+            t.stop();
+            cout << "Resultados gravados em '" << outputFile << "' com sucesso.\n"
+                 << "Duração da execução: " << t.durationMs() << endl;
+            return 0;
+        }
+
+        // @n-gramas: ids das palavras empacotados numa chave inteira
+        if (ngram > 0) {
+            ofstream out(outputFile);
+            if (!out) {
+                cerr << "Erro ao abrir arquivo de saída: " << outputFile << '\n';
+                return 1;
+            }
+            out << "{Dicionário}\n";
+            if (!runNgram(dictType, ngram, files, readOptions, out)) {
+                cerr << "Tipo de dicionário inválido: " << dictType << '\n';
+                return 1;
+            }
+            cout << "Resultados gravados em '" << outputFile << "' com sucesso.\n";
+            return 0;
+        }
+
+        // @vocabulário: codifica uma vez e conta sobre o vetor de ids
+        if (!encodeFile.empty()) {
+            ofstream out(outputFile);
+            if (!out) {
+                cerr << "Erro ao abrir arquivo de saída: " << outputFile << '\n';
+                return 1;
+            }
+            out << "{Dicionário}\n";
+            EncodedCorpus corpus;
+            if (!runEncode(dictType, files, encodeFile, readOptions, corpus)) {
+                cerr << "Tipo de dicionário inválido: " << dictType << '\n';
+                return 1;
+            }
+            writeIdCounts(corpus, threads, out);
+            cout << "Resultados gravados em '" << outputFile << "' com sucesso.\n";
+            return 0;
+        }
+
+        if (files.size() != 1 || files[0] != inputFile) {
+            ofstream out(outputFile);
+            if (!out) {
+                cerr << "Erro ao abrir arquivo de saída: " << outputFile << '\n';
+                return 1;
+            }
+            out << "{Dicionário}\n";
+            if (!runBatch(dictType, files, threads, readOptions, out)) {
+                cerr << "Tipo de dicionário inválido: " << dictType << '\n';
+                return 1;
+            }
+            cout << "Resultados gravados em '" << outputFile << "' com sucesso.\n";
+            return 0;
+        }
+
         // @iniciando processamento de strings...
-        auto words = readAndProcessText(inputFile);
+        auto words = readAndProcessText(inputFile, readOptions, threads);
+        if (!traceFile.empty()) recordTrace(words, traceFile, traceMix);
 
         ofstream out(outputFile);
 
@@ -38,16 +659,19 @@ int main(int argc, char* argv[]) {
 
             if (dictType == "dictionary_avl") 
             {
-                AVL<string, int> avl;
+                AVL<string, int, false, DictStats> avl;
+                avl.set_hot_cache(hotCacheSets);
                 t.begin();
                 for (const auto& word : words) {
-                    cout << "inserindo " << word << "..." << endl;
                     avl.insert(word);
                 }
                 cout << "criação e inserção bem-sucedidas." << endl;
-                avl.print(out);
+                if (hasRange) printRange(avl, rangeLo, rangeHi, out);
+                else avl.print(out);
+                if (DictStats::enabled) avl.stats().print(cout);
+                if (hotCacheSets > 0) avl.hot_cache_stats().print(cout);
 
-                if (avl.contains("cansado"))
+                if (DictStats::enabled && avl.contains("cansado"))
                 {
                     cout << "Tem 'cansado' no dicionário. " << endl; //
                     cout << "Quantidade de ocorrências: " << avl.get("cansado") << endl; //
@@ -67,12 +691,58 @@ int main(int argc, char* argv[]) {
          
             else if (dictType == "dictionary_rb") 
             {
-                RedBlackTree<string, int> rb;
+                RedBlackTree<string, int, false, DictStats> rb;
+                rb.set_hot_cache(hotCacheSets);
                 t.begin();
 
                 for(const auto& word : words){
                     rb.insert(word);
                 }
+                if (hasRange) printRange(rb, rangeLo, rangeHi, out);
+                if (DictStats::enabled) rb.stats().print(cout);
+                if (hotCacheSets > 0) rb.hot_cache_stats().print(cout);
+            }
+
+            else if (dictType == "dictionary_splay" || dictType == "dictionary_semisplay")
+            {
+                t.begin();
+                if (dictType == "dictionary_splay") {
+                    SplayTree<string, int, false, DictStats> splay;
+                    for (const auto& word : words) splay.insert(word);
+                    splay.print(out);
+                    if (DictStats::enabled) splay.stats().print(cout);
+                } else {
+                    SplayTree<string, int, true, DictStats> splay;
+                    for (const auto& word : words) splay.insert(word);
+                    splay.print(out);
+                    if (DictStats::enabled) splay.stats().print(cout);
+                }
+            }
+
+            else if (dictType == "dictionary_art")
+            {
+                ART<string, int> art;
+                t.begin();
+
+                for(const auto& word : words){
+                    art.insert(word);
+                }
+                art.print(out);
+            }
+
+            else if (dictType == "dictionary_hash")
+            {
+                t.begin();
+                if (!runHashTable(hashName, words, out, hashStats)) {
+                    cerr << "Função de hash inválida: " << hashName << '\n';
+                    return 1;
+                }
+            }
+
+            else if (dictType == "dictionary_skiplist")
+            {
+                t.begin();
+                runSkipList(words, threads, out);
             }
             
         else 
@@ -0,0 +1,343 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include "../include/AVL.hpp"
+#include "../include/RedBlackTree.hpp"
+#include "../include/SnapshotRedBlackTree.hpp"
+#include "../include/ConcurrentSkipList.hpp"
+
+using namespace std;
+
+// Testes de estresse das estruturas concorrentes contra um modelo
+// sequencial (std::map). Rodam com `make check`, que compila com ASan e
+// UBSan; `make -B check STRESS_SAN=-fsanitize=thread` troca pelo TSan.
+// Uma falha imprime a primeira divergência e o programa termina com 1.
+
+static atomic<int> g_failures(0);
+static mutex g_report_lock;
+
+static void fail(const string& test, const string& what) {
+    lock_guard<mutex> guard(g_report_lock);
+    if (g_failures++ < 10) cerr << "FALHA [" << test << "] " << what << endl;
+}
+
+static string keyName(size_t i) {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "k%06zu", i);
+    return buf;
+}
+
+// Compara o conteúdo em ordem de um dicionário com o modelo
+template <typename Dict>
+static void expectSame(const string& test, const Dict& dict, const map<string, int>& model) {
+    auto it = model.begin();
+    bool same = true;
+    dict.forEach([&](const string& k, const int& v) {
+        if (!same) return;
+        if (it == model.end() || it->first != k || it->second != v) {
+            fail(test, "chave " + k + " = " + to_string(v) +
+                       (it == model.end() ? ", modelo já terminou" : ", modelo tem " + it->first + " = " + to_string(it->second)));
+            same = false;
+            return;
+        }
+        ++it;
+    });
+    if (same && it != model.end()) fail(test, "faltou a chave " + it->first);
+    if (static_cast<size_t>(dict.size()) != model.size()) {
+        fail(test, "size() = " + to_string(dict.size()) + ", modelo tem " + to_string(model.size()));
+    }
+}
+
+// Lista de saltos com vários escritores. Cada thread é dona das chaves
+// i ≡ t (mod threads) e mantém um modelo exato delas, então as chaves
+// vizinhas na lista são sempre de threads diferentes e os CAS disputam os
+// mesmos ponteiros. As chaves "quentes" só recebem insert de todas as
+// threads e o total esperado é a soma dos incrementos. Um leitor percorre
+// a lista durante as escritas, conferindo a ordem, e as remoções fazem as
+// épocas liberarem nós enquanto ele lê.
+static void stressSkipList(unsigned threads, size_t keysPerThread, size_t ops, uint32_t seed) {
+    const string test = "skiplist " + to_string(threads) + "x" + to_string(keysPerThread);
+    const size_t HOT = 8;
+    ConcurrentSkipList<string, int> list;
+    vector<map<string, int>> models(threads);
+    vector<vector<int>> hot(threads, vector<int>(HOT, 0));
+    atomic<bool> writing(true);
+
+    auto writer = [&](unsigned t) {
+        mt19937 rng(seed + t);
+        map<string, int>& model = models[t];
+        for (size_t op = 0; op < ops; op++) {
+            string k = keyName((rng() % keysPerThread) * threads + t);
+            auto it = model.find(k);
+            bool present = it != model.end();
+            int v = 1 + rng() % 1000;
+            switch (rng() % 8) {
+            case 0:
+            case 1:
+                list.insert(k);
+                model[k]++;
+                break;
+            case 2:
+                list.add(k, v);
+                model[k] = v;
+                break;
+            case 3: {
+                bool threw = false;
+                try { list.update(k, v); } catch (const runtime_error&) { threw = true; }
+                if (threw == present) fail(test, "update de " + k + (present ? " lançou" : " não lançou"));
+                if (present) it->second = v;
+                break;
+            }
+            case 4:
+            case 5:
+                if (list.remove(k) != present) fail(test, "remove de " + k + " devolveu " + (present ? "false" : "true"));
+                model.erase(k);
+                break;
+            case 6: {
+                int got = list.insert_or_get(k, v);
+                int expected = present ? it->second : v;
+                if (got != expected) fail(test, "insert_or_get de " + k + " = " + to_string(got) + ", esperado " + to_string(expected));
+                model[k] = expected;
+                break;
+            }
+            default: {
+                size_t h = rng() % HOT;
+                list.insert("hot" + to_string(h));
+                hot[t][h]++;
+                if (list.contains(k) != present) fail(test, "contains de " + k);
+                break;
+            }
+            }
+        }
+    };
+
+    auto reader = [&]() {
+        mt19937 rng(seed ^ 0x9e3779b9u);
+        while (writing.load()) {
+            string prev;
+            bool first = true;
+            list.forEach([&](const string& k, const int& v) {
+                if (!first && !(prev < k)) fail(test, "forEach fora de ordem: " + prev + " antes de " + k);
+                if (v <= 0) fail(test, "forEach entregou " + k + " com valor " + to_string(v));
+                prev = k;
+                first = false;
+            });
+            string k = keyName(rng() % (keysPerThread * threads));
+            try {
+                if (list.get(k) <= 0) fail(test, "get de " + k + " fora do intervalo");
+            } catch (const runtime_error&) {
+                // removida no meio: permitido
+            }
+        }
+    };
+
+    vector<thread> pool;
+    thread watcher(reader);
+    for (unsigned t = 0; t < threads; t++) pool.emplace_back(writer, t);
+    for (auto& th : pool) th.join();
+    writing.store(false);
+    watcher.join();
+
+    map<string, int> model;
+    for (const auto& m : models) model.insert(m.begin(), m.end());
+    for (size_t h = 0; h < HOT; h++) {
+        int total = 0;
+        for (unsigned t = 0; t < threads; t++) total += hot[t][h];
+        if (total > 0) model["hot" + to_string(h)] = total;
+    }
+    expectSame(test, list, model);
+
+    list.clear();
+    if (list.size() != 0) fail(test, "clear deixou " + to_string(list.size()) + " chaves");
+}
+
+// Árvore de snapshots: um escritor transfere contagens entre chaves
+// (removendo as que zeram e criando as novas), sempre somando TOTAL em
+// cada publicação, e publica a cada 1 a 8 transferências para exercitar os
+// nós alterados no lugar. Os leitores fixam snapshots durante as escritas
+// e conferem ordem, tamanho, a soma e que a versão não muda sob eles.
+static void stressSnapshotTree(unsigned readers, size_t keys, size_t transfers, uint32_t seed) {
+    const string test = "snapshot " + to_string(readers) + "x" + to_string(keys);
+    const int TOTAL = static_cast<int>(keys) * 4;
+    SnapshotRedBlackTree<string, int> tree;
+    tree.set_publish_interval(1 << 30);
+    map<string, int> model;
+    for (size_t i = 0; i < keys; i++) {
+        tree.add(keyName(2 * i), 4);
+        model[keyName(2 * i)] = 4;
+    }
+    tree.publish();
+    atomic<bool> writing(true);
+
+    auto reader = [&](unsigned r) {
+        mt19937 rng(seed + 1000 + r);
+        while (writing.load()) {
+            auto snap = tree.snapshot();
+            vector<pair<string, int>> first;
+            long sum = 0;
+            snap.forEach([&](const string& k, const int& v) {
+                if (!first.empty() && !(first.back().first < k)) fail(test, "snapshot fora de ordem em " + k);
+                first.emplace_back(k, v);
+                sum += v;
+            });
+            if (sum != TOTAL) fail(test, "snapshot soma " + to_string(sum) + ", esperado " + to_string(TOTAL));
+            if (static_cast<size_t>(snap.size()) != first.size()) fail(test, "snapshot size() difere do percurso");
+            if (!first.empty()) {
+                const auto& e = first[rng() % first.size()];
+                if (!snap.contains(e.first) || snap.get(e.first) != e.second) fail(test, "snapshot get de " + e.first);
+            }
+            size_t i = 0;
+            bool stable = true;
+            snap.forEach([&](const string& k, const int& v) {
+                if (i >= first.size() || first[i].first != k || first[i].second != v) stable = false;
+                i++;
+            });
+            if (!stable || i != first.size()) fail(test, "snapshot mudou durante a leitura");
+        }
+    };
+
+    vector<thread> pool;
+    for (unsigned r = 0; r < readers; r++) pool.emplace_back(reader, r);
+
+    mt19937 rng(seed);
+    size_t pending = 0, batch = 1;
+    for (size_t op = 0; op < transfers; op++) {
+        auto from = model.lower_bound(keyName(rng() % (2 * keys)));
+        if (from == model.end()) from = model.begin();
+        string a = from->first;
+        string b = keyName(rng() % (2 * keys));
+        if (a == b) continue;
+        int d = 1 + rng() % from->second;
+        if (from->second == d) {
+            tree.remove(a);
+            model.erase(from);
+        } else {
+            tree.update(a, from->second - d);
+            from->second -= d;
+        }
+        auto to = model.find(b);
+        if (to == model.end()) {
+            tree.add(b, d);
+            model[b] = d;
+        } else {
+            tree.update(b, to->second + d);
+            to->second += d;
+        }
+        if (++pending >= batch) {
+            tree.publish();
+            pending = 0;
+            batch = 1 + rng() % 8;
+        }
+    }
+    tree.publish();
+    writing.store(false);
+    for (auto& th : pool) th.join();
+
+    expectSame(test, tree, model);
+}
+
+// União paralela de AVLs com estatísticas de ordem: o resultado tem de
+// ser o modelo somado, other tem de ficar vazia e rank tem de bater com a
+// posição de cada chave (os tamanhos das subárvores sobrevivem aos joins)
+static void stressUnion(unsigned threads, size_t left, size_t right, uint32_t seed) {
+    const string test = "union " + to_string(threads) + "t " + to_string(left) + "+" + to_string(right);
+    mt19937 rng(seed);
+    AVL<string, int, true> a, b;
+    map<string, int> model;
+    size_t span = 2 * (left + right) + 1;
+    for (size_t i = 0; i < left; i++) {
+        string k = keyName(rng() % span);
+        a.insert(k);
+        model[k]++;
+    }
+    for (size_t i = 0; i < right; i++) {
+        string k = keyName(rng() % span);
+        b.insert(k);
+        model[k]++;
+    }
+    a.union_with(b, [](int x, int y) { return x + y; }, threads);
+    expectSame(test, a, model);
+    if (b.size() != 0) fail(test, "other ficou com " + to_string(b.size()) + " chaves");
+    int pos = 0;
+    for (const auto& e : model) {
+        if (a.rank(e.first) != pos) {
+            fail(test, "rank de " + e.first + " = " + to_string(a.rank(e.first)) + ", esperado " + to_string(pos));
+            break;
+        }
+        pos++;
+    }
+}
+
+// Leituras concorrentes de uma árvore pronta com o cache de chaves quentes
+// ligado: get só consulta o cache, então as threads não podem disputar
+// nada (o TSan acusaria) e todas têm de ver os valores do modelo
+template <typename Tree>
+static void stressHotCacheReads(const string& name, unsigned threads, size_t keys, size_t gets, uint32_t seed) {
+    const string test = name + " get com cache " + to_string(threads) + "t";
+    mt19937 rng(seed);
+    Tree tree;
+    tree.set_hot_cache(64);
+    map<string, int> model;
+    for (size_t i = 0; i < 8 * keys; i++) {
+        // Distribuição enviesada, para o cache ter chaves quentes
+        string k = keyName(rng() % (1 + rng() % keys));
+        tree.insert(k);
+        model[k]++;
+    }
+    vector<thread> pool;
+    for (unsigned t = 0; t < threads; t++) {
+        pool.emplace_back([&, t]() {
+            mt19937 local(seed + t);
+            for (size_t i = 0; i < gets; i++) {
+                auto it = model.lower_bound(keyName(local() % (1 + local() % keys)));
+                if (it == model.end()) continue;
+                if (tree.get(it->first) != it->second) fail(test, "get de " + it->first);
+            }
+        });
+    }
+    for (auto& th : pool) th.join();
+    expectSame(test, tree, model);
+}
+
+int main(int argc, char* argv[]) {
+    // Multiplica o número de operações (padrão 1, alguns segundos com ASan)
+    size_t scale = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1;
+    if (scale == 0) scale = 1;
+    uint32_t seed = argc > 2 ? static_cast<uint32_t>(strtoul(argv[2], nullptr, 10)) : random_device{}();
+    cout << "semente " << seed << endl;
+
+    for (unsigned threads : {2u, 4u, 8u}) {
+        stressSkipList(threads, 16, 20000 * scale, seed + threads);
+        stressSkipList(threads, 1024, 20000 * scale, seed + 100 + threads);
+    }
+    cout << "skiplist: " << (g_failures.load() ? "FALHOU" : "ok") << endl;
+
+    int before = g_failures.load();
+    stressSnapshotTree(3, 32, 20000 * scale, seed);
+    stressSnapshotTree(3, 2048, 20000 * scale, seed + 1);
+    cout << "snapshot: " << (g_failures.load() > before ? "FALHOU" : "ok") << endl;
+
+    before = g_failures.load();
+    for (size_t round = 0; round < 20 * scale; round++) {
+        unsigned threads = 1u << (round % 4);
+        size_t left = round % 3 == 0 ? 0 : 1 + (seed + round * 7919) % 20000;
+        size_t right = 1 + (seed + round * 104729) % 20000;
+        stressUnion(threads, left, right, seed + static_cast<uint32_t>(round));
+    }
+    cout << "union_with: " << (g_failures.load() > before ? "FALHOU" : "ok") << endl;
+
+    before = g_failures.load();
+    stressHotCacheReads<AVL<string, int>>("avl", 4, 4096, 20000 * scale, seed);
+    stressHotCacheReads<RedBlackTree<string, int>>("rb", 4, 4096, 20000 * scale, seed + 1);
+    cout << "cache quente: " << (g_failures.load() > before ? "FALHOU" : "ok") << endl;
+
+    return g_failures.load() ? 1 : 0;
+}